@@ -17,9 +17,13 @@ public:
 	virtual ~Application()					   = default;
 
 protected:
+	// update() and handle_events() run on the main thread, draw() on the render thread. That is the main thread
+	// too when the video driver cannot render from another one.
 	virtual void update()						   = 0;
-	virtual void draw() const					   = 0;
+	virtual void draw()							   = 0;
 	virtual void handle_events(const SDL_Event& e) = 0;
+	// Called on the render thread before the renderer is destroyed, to free what was created with it.
+	virtual void release_renderer() {}
 
 	friend class ::graphics::window::Window;
 };
@@ -0,0 +1,73 @@
+#ifndef CHESS_INCLUDE_CLI_SHELL_HPP
+#define CHESS_INCLUDE_CLI_SHELL_HPP
+
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "engine/cache.hpp"
+#include "engine/search.hpp"
+#include "engine/tt.hpp"
+#include "game/game.hpp"
+
+namespace cli {
+
+// Line based front end to the engine core, usable without a display. Speaks enough UCI to be driven by a
+// GUI or a match runner. Searches run on a thread of their own so that `stop` and `isready` are answered
+// while they run; any other command waits for the search to end first. With an analysis file set, deep
+// results are loaded when the option is set and written back when the shell stops.
+class Shell final {
+public:
+	Shell(std::istream &input, std::ostream &output);
+
+	Shell(const Shell &)			= delete;
+	Shell &operator=(const Shell &) = delete;
+
+	~Shell();
+
+	void run();
+	bool execute(const std::string &line);
+
+private:
+	typedef std::function<void(std::istringstream &)> Command;
+
+	void										   uci(std::istringstream &args);
+	void										   setoption(std::istringstream &args);
+	void										   position(std::istringstream &args);
+	void										   go(std::istringstream &args);
+	void										   stop(std::istringstream &args);
+	void										   perft(std::istringstream &args);
+	void										   display(std::istringstream &args);
+	void										   evaluate(std::istringstream &args);
+	void										   sliders(std::istringstream &args);
+	void										   bench(std::istringstream &args);
+
+	void										   think(app::engine::Limits limits, bool infinite_search);
+	void										   wait_for_search();
+
+	std::istream								  &in;
+	std::ostream								  &out;
+	app::game::Board							   board;
+	app::engine::TranspositionTable				   tt;
+	app::engine::AnalysisCache					   cache;
+	std::filesystem::path						   analysis_file;
+	app::engine::Search							   search;
+	size_t										   threads;
+	std::map<std::string, Command, std::less<> >   commands;
+
+	// Guards `out` while a search is running.
+	std::mutex									   out_mutex;
+	std::thread									   searcher;
+	bool										   infinite;
+	std::atomic<bool>							   stop_requested;
+};
+
+}  // namespace cli
+
+#endif	// CHESS_INCLUDE_CLI_SHELL_HPP
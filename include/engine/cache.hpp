@@ -0,0 +1,69 @@
+#ifndef CHESS_INCLUDE_ENGINE_CACHE_HPP
+#define CHESS_INCLUDE_ENGINE_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <unordered_map>
+
+#include "engine/tt.hpp"
+#include "game/move.hpp"
+
+namespace app::engine {
+
+// 16 bytes on disk. Unlike a table entry the full key is kept, so records can be placed back into a table
+// of any size.
+struct CacheRecord {
+	uint64_t key;
+	uint16_t move16;
+	int16_t	 value16;
+	uint8_t	 depth8;
+	uint8_t	 bound8;
+	uint8_t	 padding[2];
+};
+
+static_assert(sizeof(CacheRecord) == 16);
+
+// Deep search results that outlive the process. The search records every node searched to at least
+// `min_depth`; the records are written to a file on shutdown and read back, memory mapped, into the
+// transposition table of the next session, which then resumes from the depth reached before.
+class AnalysisCache final {
+public:
+	static constexpr int	DEFAULT_MIN_DEPTH = 8;
+	static constexpr size_t DEFAULT_CAPACITY  = 1 << 20;
+
+	explicit AnalysisCache(int min_depth = DEFAULT_MIN_DEPTH, size_t capacity = DEFAULT_CAPACITY);
+
+	AnalysisCache(const AnalysisCache &)			= delete;
+	AnalysisCache &operator=(const AnalysisCache &) = delete;
+
+	~AnalysisCache()								= default;
+
+	// Keeps the deepest result per key; `value` is already relative to the node, as stored in the table. When
+	// full, the shallowest records make way for new ones.
+	void				 record(uint64_t key, int value, Bound bound, int depth, game::Move m);
+
+	// Reads the records of `path` and stores them into `tt`. Returns the number of records, 0 when the file
+	// is missing or is not a cache file.
+	size_t				 load(const std::filesystem::path &path, TranspositionTable &tt);
+	// Stores the records held in memory into `tt`, e.g. after the table was cleared or resized.
+	void				 import(TranspositionTable &tt) const;
+	// Writes the records sorted by key, through a temporary file so that an interrupted save keeps the old one.
+	bool				 save(const std::filesystem::path &path) const;
+
+	void				 clear();
+
+	[[nodiscard]] int	 min_depth() const;
+	[[nodiscard]] size_t size() const;
+
+private:
+	bool									  make_room(int depth);
+
+	int										  depth_threshold;
+	size_t									  max_records;
+	std::unordered_map<uint64_t, CacheRecord> records;
+};
+
+}  // namespace app::engine
+
+#endif	// CHESS_INCLUDE_ENGINE_CACHE_HPP
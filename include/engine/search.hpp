@@ -0,0 +1,98 @@
+#ifndef CHESS_INCLUDE_ENGINE_SEARCH_HPP
+#define CHESS_INCLUDE_ENGINE_SEARCH_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "engine/cache.hpp"
+#include "engine/tt.hpp"
+#include "game/game.hpp"
+#include "game/move.hpp"
+
+namespace app::engine {
+
+constexpr int MAX_PLY				= 128;
+
+constexpr int VALUE_DRAW			= 0;
+constexpr int VALUE_MATE			= 32000;
+constexpr int VALUE_INFINITE		= 32001;
+constexpr int VALUE_MATE_IN_MAX_PLY = VALUE_MATE - MAX_PLY;
+
+struct Limits {
+	int									depth	  = MAX_PLY - 1;
+	uint64_t							nodes	  = 0;
+	int64_t								movetime  = 0;
+	std::array<int64_t, game::COLOR_NB> time	  = {};
+	std::array<int64_t, game::COLOR_NB> inc		  = {};
+	int									movestogo = 0;
+};
+
+// Outcome of one completed iteration; the last one is the search result.
+struct Info {
+	int						depth;
+	int						score;
+	uint64_t				nodes;
+	int64_t					time_ms;
+	int						hashfull;
+	std::vector<game::Move> pv;
+};
+
+// Single-threaded iterative deepening alpha-beta with quiescence search, using the shared transposition
+// table for cutoffs and move ordering. Deep results are also handed to the analysis cache, when there is one.
+class Search final {
+public:
+	typedef std::function<void(const Info &)> Listener;
+
+	explicit Search(TranspositionTable &table, AnalysisCache *analysis = nullptr);
+
+	Search(const Search &)			  = delete;
+	Search &operator=(const Search &) = delete;
+
+	~Search()						  = default;
+
+	Info				   run(game::Board &board, const Limits &search_limits, const Listener &on_iteration = {});
+
+	// Safe from another thread. A stop that comes before the search starts still applies to it, until
+	// clear_stop() is called.
+	void				   stop();
+	void				   clear_stop();
+
+	[[nodiscard]] uint64_t nodes() const;
+
+private:
+	typedef std::chrono::steady_clock Clock;
+	typedef std::array<std::array<int, game::bitboard::SQUARE_NB>, game::bitboard::SQUARE_NB> ButterflyTable;
+
+	int					  negamax(game::Board &board, int alpha, int beta, int depth, int ply);
+	int					  qsearch(game::Board &board, int alpha, int beta, int ply);
+
+	void				  score_moves(const game::Board &board, game::MoveList<> &moves, game::Move tt_move,
+						   int ply) const;
+	void				  update_pv(int ply, game::Move m);
+	void				  check_limits();
+	[[nodiscard]] int64_t elapsed() const;
+
+	TranspositionTable								   &tt;
+	AnalysisCache									   *cache;
+	std::atomic<bool>									stopped;
+	std::atomic<bool>									stop_signal;
+	uint64_t											node_count;
+
+	Limits												limits;
+	Clock::time_point									start;
+	int64_t												optimum_ms;
+	int64_t												maximum_ms;
+
+	std::array<std::array<game::Move, 2>, MAX_PLY>		killers;
+	std::array<ButterflyTable, game::COLOR_NB>			history;
+	std::array<std::array<game::Move, MAX_PLY>, MAX_PLY> pv_table;
+	std::array<int, MAX_PLY>							pv_length;
+};
+
+}  // namespace app::engine
+
+#endif	// CHESS_INCLUDE_ENGINE_SEARCH_HPP
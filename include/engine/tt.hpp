@@ -0,0 +1,100 @@
+#ifndef CHESS_INCLUDE_ENGINE_TT_HPP
+#define CHESS_INCLUDE_ENGINE_TT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "game/move.hpp"
+
+namespace app::engine {
+
+enum Bound : uint8_t {
+	BOUND_NONE,
+	BOUND_UPPER,
+	BOUND_LOWER,
+	BOUND_EXACT = BOUND_UPPER | BOUND_LOWER,
+};
+
+// Stored depths are shifted so that quiescence entries (depth -1) are distinct from empty slots (0).
+constexpr int DEPTH_ENTRY_OFFSET = -2;
+
+// 8 bytes: the upper bits of the key choose the cluster, the lower 16 bits are checked on probe.
+struct TTEntry {
+	uint16_t key16;
+	uint16_t move16;
+	int16_t	 value16;
+	uint8_t	 depth8;
+	uint8_t	 gen_bound8;
+
+	[[nodiscard]] game::Move move() const {
+		return game::Move(move16);
+	}
+
+	[[nodiscard]] int value() const {
+		return value16;
+	}
+
+	[[nodiscard]] int depth() const {
+		return depth8 + DEPTH_ENTRY_OFFSET;
+	}
+
+	[[nodiscard]] Bound bound() const {
+		return static_cast<Bound>(gen_bound8 & 3);
+	}
+
+	void save(uint64_t key, int value, Bound bound, int depth, game::Move m, uint8_t generation);
+};
+
+class TranspositionTable final {
+public:
+	static constexpr size_t CLUSTER_SIZE = 4;
+
+	TranspositionTable()									  = default;
+	TranspositionTable(const TranspositionTable &)			  = delete;
+	TranspositionTable &operator=(const TranspositionTable &) = delete;
+
+	~TranspositionTable();
+
+	// Reallocates the table with `mb` megabytes and clears it with `threads` threads.
+	void							 resize(size_t mb, size_t threads = 1);
+	void							 clear(size_t threads = 1);
+
+	void							 new_search();
+
+	// Entry holding `key` when `found`, otherwise the entry of the cluster that should be replaced.
+	[[nodiscard]] TTEntry			*probe(uint64_t key, bool &found) const;
+	[[nodiscard]] uint8_t			 generation() const;
+
+	// Permille of sampled entries written during the current search.
+	[[nodiscard]] int				 hashfull() const;
+
+	[[nodiscard]] size_t			 size_mb() const;
+	// Page size the table actually ended up on, e.g. "2 MB pages (hugetlbfs)".
+	[[nodiscard]] const std::string &page_info() const;
+
+private:
+	struct alignas(32) Cluster {
+		TTEntry entries[CLUSTER_SIZE];
+	};
+
+	enum class Allocation {
+		NONE,
+		HUGETLB,
+		ALIGNED,
+	};
+
+	void		release();
+	void		update_page_info();
+
+	Cluster	   *table		  = nullptr;
+	size_t		cluster_count = 0;
+	size_t		bytes		  = 0;
+	Allocation	allocation	  = Allocation::NONE;
+	uint8_t		gen8		  = 0;
+	std::string pages;
+};
+
+}  // namespace app::engine
+
+#endif	// CHESS_INCLUDE_ENGINE_TT_HPP
@@ -0,0 +1,19 @@
+#ifndef CHESS_INCLUDE_GAME_BITBASE_HPP
+#define CHESS_INCLUDE_GAME_BITBASE_HPP
+
+#include "game/bitboard.hpp"
+#include "game/piece.hpp"
+
+namespace app::game::bitbase {
+
+// King and pawn versus king: one win/draw bit for each of the 196608 positions with white holding the
+// pawn on files a to d, solved by retrograde analysis at startup (24 KB, a few milliseconds).
+void			   init();
+
+// Whether white wins with the given placement. Callers mirror the position so that the strong side is
+// white and its pawn stands on files a to d.
+[[nodiscard]] bool probe(bitboard::Square wksq, bitboard::Square wpsq, bitboard::Square bksq, Color stm);
+
+}  // namespace app::game::bitbase
+
+#endif	// CHESS_INCLUDE_GAME_BITBASE_HPP
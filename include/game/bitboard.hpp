@@ -0,0 +1,240 @@
+#ifndef CHESS_INCLUDE_GAME_BITBOARD_HPP
+#define CHESS_INCLUDE_GAME_BITBOARD_HPP
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <utility>
+
+#if defined(__BMI2__)
+	#include <immintrin.h>
+#endif
+
+#include "game/piece.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+	#define CHESS_HAS_PEXT 1
+#endif
+
+namespace app::game::bitboard {
+
+// Squares follow the board storage order: index 0 is a8, index 63 is h1.
+typedef uint64_t   Bitboard;
+typedef uint8_t	   Square;
+
+constexpr Square   SQUARE_NB = 64;
+constexpr Square   NO_SQUARE = SQUARE_NB;
+
+constexpr Bitboard FILE_A	 = 0x0101010101010101ULL;
+constexpr Bitboard FILE_H	 = FILE_A << 7;
+constexpr Bitboard ROW_0	 = 0xFFULL;
+constexpr Bitboard ROW_7	 = ROW_0 << 56;
+
+constexpr Bitboard row_bb(uint8_t row) {
+	return ROW_0 << (8 * row);
+}
+
+// Row holding the `rank`-th rank as seen from color C, rank 0 being C's back rank.
+template <Color C>
+constexpr Bitboard relative_rank_bb(uint8_t rank) {
+	return row_bb(C == WHITE ? 7 - rank : rank);
+}
+
+constexpr Square make_square(uint8_t x, uint8_t y) {
+	return static_cast<Square>(y * 8 + x);
+}
+
+constexpr uint8_t file_of(Square s) {
+	return s & 7;
+}
+
+constexpr uint8_t row_of(Square s) {
+	return s >> 3;
+}
+
+constexpr Bitboard square_bb(Square s) {
+	return 1ULL << s;
+}
+
+inline Square lsb(Bitboard b) {
+	return static_cast<Square>(std::countr_zero(b));
+}
+
+inline Square pop_lsb(Bitboard &b) {
+	Square s  = lsb(b);
+	b		 &= b - 1;
+	return s;
+}
+
+inline bool more_than_one(Bitboard b) {
+	return b & (b - 1);
+}
+
+// Direction offsets are expressed in board storage order, so "north" goes towards row 0 (rank 8).
+enum Direction : int8_t {
+	NORTH	   = -8,
+	SOUTH	   = 8,
+	EAST	   = 1,
+	WEST	   = -1,
+	NORTH_EAST = NORTH + EAST,
+	NORTH_WEST = NORTH + WEST,
+	SOUTH_EAST = SOUTH + EAST,
+	SOUTH_WEST = SOUTH + WEST,
+};
+
+template <Direction D>
+constexpr Bitboard shift(Bitboard b) {
+	if constexpr (D == NORTH) return b >> 8;
+	if constexpr (D == SOUTH) return b << 8;
+	if constexpr (D == EAST) return (b & ~FILE_H) << 1;
+	if constexpr (D == WEST) return (b & ~FILE_A) >> 1;
+	if constexpr (D == NORTH_EAST) return (b & ~FILE_H) >> 7;
+	if constexpr (D == NORTH_WEST) return (b & ~FILE_A) >> 9;
+	if constexpr (D == SOUTH_EAST) return (b & ~FILE_H) << 9;
+	if constexpr (D == SOUTH_WEST) return (b & ~FILE_A) << 7;
+	return 0;
+}
+
+template <Color C>
+constexpr Direction pawn_push() {
+	return C == WHITE ? NORTH : SOUTH;
+}
+
+template <Color C>
+constexpr Bitboard pawn_attacks_bb(Bitboard pawns) {
+	if constexpr (C == WHITE) return shift<NORTH_EAST>(pawns) | shift<NORTH_WEST>(pawns);
+	return shift<SOUTH_EAST>(pawns) | shift<SOUTH_WEST>(pawns);
+}
+
+namespace detail {
+
+template <size_t N>
+constexpr std::array<Bitboard, SQUARE_NB> leaper_table(const std::array<std::pair<int, int>, N> &steps) {
+	std::array<Bitboard, SQUARE_NB> table{};
+
+	for (Square s = 0; s < SQUARE_NB; s++) {
+		for (const auto &[dx, dy] : steps) {
+			int x = file_of(s) + dx;
+			int y = row_of(s) + dy;
+
+			if (0 <= x && x < 8 && 0 <= y && y < 8) table[s] |= square_bb(make_square(x, y));
+		}
+	}
+
+	return table;
+}
+
+constexpr std::array<std::pair<int, int>, 8> KNIGHT_STEPS{
+	{{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}}
+};
+constexpr std::array<std::pair<int, int>, 8> KING_STEPS{
+	{{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}}
+};
+constexpr std::array<std::pair<int, int>, 2> WHITE_PAWN_STEPS{
+	{{-1, -1}, {1, -1}}
+};
+constexpr std::array<std::pair<int, int>, 2> BLACK_PAWN_STEPS{
+	{{-1, 1}, {1, 1}}
+};
+
+constexpr auto KNIGHT_ATTACKS = leaper_table(KNIGHT_STEPS);
+constexpr auto KING_ATTACKS	  = leaper_table(KING_STEPS);
+constexpr std::array<std::array<Bitboard, SQUARE_NB>, COLOR_NB> PAWN_ATTACKS{
+	leaper_table(BLACK_PAWN_STEPS),
+	leaper_table(WHITE_PAWN_STEPS),
+};
+
+#ifdef CHESS_HAS_PEXT
+// Set by init() once CPUID confirms a fast PEXT; otherwise the tables are laid out for magic indexing.
+extern bool USE_PEXT;
+
+inline uint64_t pext(uint64_t b, uint64_t mask) {
+	#if defined(__BMI2__)
+	return _pext_u64(b, mask);
+	#else
+	// Built without -mbmi2: emit the instruction directly, it only runs once CPUID has vouched for it.
+	asm("pextq %2, %1, %0" : "=r"(b) : "r"(b), "r"(mask));
+	return b;
+	#endif
+}
+#endif
+
+struct Magic {
+	Bitboard  mask;
+	Bitboard  magic;
+	Bitboard *attacks;
+	unsigned  shift;
+
+	[[nodiscard]] size_t index(Bitboard occupied) const {
+#ifdef CHESS_HAS_PEXT
+		if (USE_PEXT) return pext(occupied, mask);
+#endif
+		return ((occupied & mask) * magic) >> shift;
+	}
+};
+
+extern std::array<Magic, SQUARE_NB>						   ROOK_MAGICS;
+extern std::array<Magic, SQUARE_NB>						   BISHOP_MAGICS;
+
+extern std::array<std::array<Bitboard, SQUARE_NB>, SQUARE_NB> BETWEEN;
+extern std::array<std::array<Bitboard, SQUARE_NB>, SQUARE_NB> LINE;
+
+}  // namespace detail
+
+enum class SliderBackend {
+	AUTO,
+	MAGIC,
+	PEXT,
+};
+
+// Builds the slider tables. AUTO picks PEXT on CPUs that run it natively and magic multiplication elsewhere;
+// asking for PEXT on a CPU without BMI2 falls back to magics. Calling it again rebuilds the tables.
+void						init(SliderBackend backend = SliderBackend::AUTO);
+[[nodiscard]] SliderBackend slider_backend();
+[[nodiscard]] const char   *slider_backend_name();
+
+constexpr Bitboard pawn_attacks(Color c, Square s) {
+	return detail::PAWN_ATTACKS[c][s];
+}
+
+constexpr Bitboard knight_attacks(Square s) {
+	return detail::KNIGHT_ATTACKS[s];
+}
+
+constexpr Bitboard king_attacks(Square s) {
+	return detail::KING_ATTACKS[s];
+}
+
+inline Bitboard bishop_attacks(Square s, Bitboard occupied) {
+	const detail::Magic &m = detail::BISHOP_MAGICS[s];
+	return m.attacks[m.index(occupied)];
+}
+
+inline Bitboard rook_attacks(Square s, Bitboard occupied) {
+	const detail::Magic &m = detail::ROOK_MAGICS[s];
+	return m.attacks[m.index(occupied)];
+}
+
+inline Bitboard queen_attacks(Square s, Bitboard occupied) {
+	return bishop_attacks(s, occupied) | rook_attacks(s, occupied);
+}
+
+Bitboard attacks(PieceType pt, Square s, Bitboard occupied);
+
+// Squares strictly between `a` and `b`, or nothing when they do not share a line or diagonal.
+inline Bitboard between(Square a, Square b) {
+	return detail::BETWEEN[a][b];
+}
+
+// Whole line or diagonal going through `a` and `b`, or nothing when they are not aligned.
+inline Bitboard line(Square a, Square b) {
+	return detail::LINE[a][b];
+}
+
+inline bool aligned(Square a, Square b, Square c) {
+	return line(a, b) & square_bb(c);
+}
+
+}  // namespace app::game::bitboard
+
+#endif	// CHESS_INCLUDE_GAME_BITBOARD_HPP
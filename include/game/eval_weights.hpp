@@ -0,0 +1,33 @@
+#ifndef CHESS_INCLUDE_GAME_EVAL_WEIGHTS_HPP
+#define CHESS_INCLUDE_GAME_EVAL_WEIGHTS_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "game/evaluate.hpp"
+
+namespace app::game::eval {
+
+// Middlegame and endgame weight of each term, in centipawns.
+constexpr std::array<std::array<int16_t, 2>, TERM_NB> WEIGHTS{{
+	{82, 94},		// PAWN_VALUE
+	{337, 281},		// KNIGHT_VALUE
+	{365, 297},		// BISHOP_VALUE
+	{477, 512},		// ROOK_VALUE
+	{1025, 936},	// QUEEN_VALUE
+	{30, 50},		// BISHOP_PAIR
+	{4, 4},			// KNIGHT_MOBILITY
+	{5, 5},			// BISHOP_MOBILITY
+	{3, 5},			// ROOK_MOBILITY
+	{1, 2},			// QUEEN_MOBILITY
+	{2, 0},			// SPACE
+	{6, 0},			// KING_ZONE_ATTACKS
+	{10, 0},		// PAWN_SHIELD
+	{5, 15},		// PASSED_PAWN
+	{-10, -20},		// DOUBLED_PAWN
+	{-8, -12},		// ISOLATED_PAWN
+}};
+
+}  // namespace app::game::eval
+
+#endif	// CHESS_INCLUDE_GAME_EVAL_WEIGHTS_HPP
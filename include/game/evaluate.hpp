@@ -0,0 +1,51 @@
+#ifndef CHESS_INCLUDE_GAME_EVALUATE_HPP
+#define CHESS_INCLUDE_GAME_EVALUATE_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "game/game.hpp"
+
+namespace app::game {
+
+namespace eval {
+
+enum Term : uint8_t {
+	PAWN_VALUE,
+	KNIGHT_VALUE,
+	BISHOP_VALUE,
+	ROOK_VALUE,
+	QUEEN_VALUE,
+	BISHOP_PAIR,
+	KNIGHT_MOBILITY,
+	BISHOP_MOBILITY,
+	ROOK_MOBILITY,
+	QUEEN_MOBILITY,
+	SPACE,
+	KING_ZONE_ATTACKS,
+	PAWN_SHIELD,
+	PASSED_PAWN,
+	DOUBLED_PAWN,
+	ISOLATED_PAWN,
+	TERM_NB,
+};
+
+constexpr int PHASE_MAX = 24;
+
+// Evaluation is linear in its weights: each term contributes weight * feature, with the feature counted
+// for white minus black, and the middlegame and endgame sums are blended by game phase.
+struct Trace {
+	std::array<int, TERM_NB> features;
+	int						 phase;
+};
+
+[[nodiscard]] Trace trace(const Board &board);
+
+}  // namespace eval
+
+// Static evaluation in centipawns from the side to move's point of view.
+[[nodiscard]] int evaluate(const Board &board);
+
+}  // namespace app::game
+
+#endif	// CHESS_INCLUDE_GAME_EVALUATE_HPP
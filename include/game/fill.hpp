@@ -0,0 +1,66 @@
+#ifndef CHESS_INCLUDE_GAME_FILL_HPP
+#define CHESS_INCLUDE_GAME_FILL_HPP
+
+#include "game/bitboard.hpp"
+
+namespace app::game::bitboard {
+
+// Set-wise attack generation: instead of one table lookup per piece, every piece of a set is flooded at
+// once with Kogge-Stone fills. Evaluation uses these to build whole-side attack maps.
+
+// Destination squares a step in direction D may land on without wrapping around the board edge.
+template <Direction D>
+constexpr Bitboard no_wrap() {
+	if constexpr (D == EAST || D == NORTH_EAST || D == SOUTH_EAST) return ~FILE_A;
+	if constexpr (D == WEST || D == NORTH_WEST || D == SOUTH_WEST) return ~FILE_H;
+	return ~0ULL;
+}
+
+template <Direction D>
+constexpr Bitboard raw_shift(Bitboard b, int steps) {
+	return D > 0 ? b << (D * steps) : b >> (-D * steps);
+}
+
+// Squares attacked along direction D by the sliders in `gen`, stopping on the first occupied square.
+template <Direction D>
+constexpr Bitboard kogge_stone(Bitboard gen, Bitboard empty) {
+	Bitboard pro  = empty & no_wrap<D>();
+
+	gen			 |= pro & raw_shift<D>(gen, 1);
+	pro			 &= raw_shift<D>(pro, 1);
+	gen			 |= pro & raw_shift<D>(gen, 2);
+	pro			 &= raw_shift<D>(pro, 2);
+	gen			 |= pro & raw_shift<D>(gen, 4);
+
+	return raw_shift<D>(gen, 1) & no_wrap<D>();
+}
+
+constexpr Bitboard knight_fill(Bitboard knights) {
+	Bitboard east  = shift<EAST>(knights);
+	Bitboard west  = shift<WEST>(knights);
+	Bitboard east2 = shift<EAST>(east);
+	Bitboard west2 = shift<WEST>(west);
+
+	return ((east | west) << 16) | ((east | west) >> 16) | ((east2 | west2) << 8) | ((east2 | west2) >> 8);
+}
+
+constexpr Bitboard king_fill(Bitboard kings) {
+	Bitboard row = kings | shift<EAST>(kings) | shift<WEST>(kings);
+	return (row | (row << 8) | (row >> 8)) & ~kings;
+}
+
+struct SliderFill {
+	Bitboard orthogonal;
+	Bitboard diagonal;
+};
+
+// Attacks of every slider in `orthogonal` along ranks and files and of every slider in `diagonal` along
+// diagonals. All eight directions are filled together: four per AVX2 register when the CPU has it, one by
+// one otherwise.
+[[nodiscard]] SliderFill  slider_fill(Bitboard orthogonal, Bitboard diagonal, Bitboard occupied);
+
+[[nodiscard]] const char *fill_backend_name();
+
+}  // namespace app::game::bitboard
+
+#endif	// CHESS_INCLUDE_GAME_FILL_HPP
@@ -2,20 +2,46 @@
 #define CHESS_INCLUDE_GAME_GAME_HPP
 
 #include <bitset>
+#include <exception>
 #include <optional>
-#include <unordered_map>
+#include <string>
 #include <vector>
 
 #include "coord.hpp"
+#include "game/bitboard.hpp"
+#include "game/move.hpp"
 #include "game/piece.hpp"
-#include "graphics/image.hpp"
-#include "graphics/text.hpp"
-#include "graphics/window.hpp"
 
 namespace app::game {
 
+enum CastlingRights : uint8_t {
+	NO_CASTLING	 = 0,
+	WHITE_OO	 = 1,
+	WHITE_OOO	 = 2,
+	BLACK_OO	 = 4,
+	BLACK_OOO	 = 8,
+	ANY_CASTLING = WHITE_OO | WHITE_OOO | BLACK_OO | BLACK_OOO,
+};
+
+class InvalidFenException : public std::exception {
+public:
+	InvalidFenException(const std::string &fen, const std::string &reason);
+
+	InvalidFenException(const InvalidFenException &)			= default;
+	InvalidFenException &operator=(const InvalidFenException &) = default;
+
+	~InvalidFenException() override								= default;
+
+	[[nodiscard]] const char *what() const noexcept override;
+
+private:
+	std::string msg;
+};
+
 class Board {
 public:
+	static constexpr const char *START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
 	explicit Board(bool empty = false);
 
 	~Board()														= default;
@@ -23,6 +49,9 @@ public:
 	Board								  &operator=(const Board &) = delete;
 
 	void								   init_board();
+	void								   set_fen(const std::string &fen);
+	[[nodiscard]] std::string			   fen() const;
+
 	void								   flip();
 	[[nodiscard]] bool					   flipped() const;
 
@@ -32,22 +61,93 @@ public:
 
 	[[nodiscard]] std::optional<PieceKind> at(size_t x, size_t y) const;
 	[[nodiscard]] std::optional<PieceKind> at(const coord::Agnostic &c) const;
+	[[nodiscard]] uint8_t				   piece_on(bitboard::Square s) const;
+	[[nodiscard]] PieceType				   type_on(bitboard::Square s) const;
 
-	void move_with_hint(const PieceKind &kind, const coord::Agnostic &origin, const coord::Agnostic &target);
+	[[nodiscard]] bitboard::Bitboard	   pieces() const;
+	[[nodiscard]] bitboard::Bitboard	   pieces(Color c) const;
+	[[nodiscard]] bitboard::Bitboard	   pieces(PieceType pt) const;
+	[[nodiscard]] bitboard::Bitboard	   pieces(Color c, PieceType pt) const;
+	[[nodiscard]] bitboard::Square		   king_square(Color c) const;
 
-private:
-	typedef std::bitset<64>					bitboard;
+	[[nodiscard]] Color					   side_to_move() const;
+	[[nodiscard]] uint8_t				   castling_rights() const;
+	[[nodiscard]] bitboard::Square		   en_passant_square() const;
+	[[nodiscard]] uint8_t				   halfmove_clock() const;
+	[[nodiscard]] uint64_t				   key() const;
+
+	// Earlier occurrences of the current position; one inside the last `ply` moves counts as two, which is
+	// what a search rooted `ply` moves ago wants.
+	[[nodiscard]] int					   repetitions(int ply = 0) const;
+	// Fifty-move rule or threefold repetition (see repetitions() for `ply`).
+	[[nodiscard]] bool					   is_draw(int ply = 0) const;
+
+	[[nodiscard]] bitboard::Bitboard	   attackers_to(bitboard::Square s, bitboard::Bitboard occupied) const;
 
-	void									dump_subboard(const PieceKind &kind) const;
-	void									dump_merged_board() const;
+	[[nodiscard]] bitboard::Bitboard	   checkers(Color c) const;
+	[[nodiscard]] bitboard::Bitboard	   pinned(Color c) const;
+	[[nodiscard]] bitboard::Bitboard	   attacked_by(Color c) const;
+	[[nodiscard]] bool					   in_check(Color c) const;
 
-	[[nodiscard]] bool						check_static_move_validity(const PieceKind &kind,
-							const coord::Agnostic										   &origin,
-							const coord::Agnostic										   &target) const;
+	// Legality of a pseudo-legal move for the side to move, answered from the cached pins and checkers.
+	[[nodiscard]] bool					   legal(Move m) const;
 
-	std::unordered_map<PieceKind, bitboard> boards;
-	bool									is_flipped;
-	bool									base_game_pos;
+	void								   do_move(Move m);
+	void								   undo_move(Move m);
+
+	template <Color Us>
+	void do_move(Move m);
+	template <Color Us>
+	void undo_move(Move m);
+
+	void move_with_hint(const PieceKind &kind, const coord::Agnostic &origin, const coord::Agnostic &target);
+
+private:
+	typedef std::bitset<64> BitSet;
+
+	// Ring of position keys indexed by game ply. The rule50 window never exceeds 255 plies, so the entries
+	// a repetition scan reads are never overwritten.
+	static constexpr size_t HISTORY_SIZE = 256;
+
+	// Refreshed once per position change so legality tests and the GUI never rescan the board.
+	struct CheckInfo {
+		std::array<bitboard::Bitboard, COLOR_NB> checkers;
+		std::array<bitboard::Bitboard, COLOR_NB> pinned;
+		std::array<bitboard::Bitboard, COLOR_NB> attacked;
+	};
+
+	// Everything do_move() cannot recompute when taking a move back.
+	struct State {
+		uint8_t			 castling;
+		bitboard::Square ep_square;
+		uint8_t			 rule50;
+		uint8_t			 captured;
+		uint64_t		 key;
+		CheckInfo		 check_info;
+	};
+
+	void							 dump_subboard(const PieceKind &kind) const;
+	void							 dump_merged_board() const;
+
+	void							 clear();
+	void							 put_pieces(const PieceKind &kind, bitboard::Bitboard squares);
+	void							 put_piece(uint8_t piece, bitboard::Square s);
+	void							 remove_piece(bitboard::Square s);
+	void							 move_piece(bitboard::Square from, bitboard::Square to);
+	void							 update_check_info();
+
+	template <Color Us>
+	[[nodiscard]] bitboard::Bitboard compute_attacks() const;
+
+	std::array<uint8_t, bitboard::SQUARE_NB>	  mailbox;
+	std::array<bitboard::Bitboard, COLOR_NB>	  by_color;
+	std::array<bitboard::Bitboard, PIECE_TYPE_NB> by_type;
+	std::vector<State>							  states;
+	std::array<uint64_t, HISTORY_SIZE>			  key_history;
+	Color										  side;
+	int											  game_ply;
+	bool										  is_flipped;
+	bool										  base_game_pos;
 };
 
 }  // namespace app::game
@@ -0,0 +1,181 @@
+#ifndef CHESS_INCLUDE_GAME_MOVE_HPP
+#define CHESS_INCLUDE_GAME_MOVE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "game/bitboard.hpp"
+#include "game/piece.hpp"
+
+namespace app::game {
+
+// Packed move: bits 0-5 origin, 6-11 target, 12-13 promotion piece (knight to queen), 14-15 flag.
+class Move final {
+public:
+	enum Flag : uint16_t {
+		NORMAL	   = 0,
+		PROMOTION  = 1 << 14,
+		EN_PASSANT = 2 << 14,
+		CASTLING   = 3 << 14,
+	};
+
+	Move() = default;
+
+	constexpr explicit Move(uint16_t raw)
+		: data(raw) {
+	}
+
+	constexpr Move(bitboard::Square from, bitboard::Square to, Flag flag = NORMAL, PieceType promotion = KNIGHT)
+		: data(static_cast<uint16_t>(flag | ((promotion - KNIGHT) << 12) | (to << 6) | from)) {
+	}
+
+	[[nodiscard]] constexpr bitboard::Square from() const {
+		return data & 0x3F;
+	}
+
+	[[nodiscard]] constexpr bitboard::Square to() const {
+		return (data >> 6) & 0x3F;
+	}
+
+	[[nodiscard]] constexpr Flag flag() const {
+		return static_cast<Flag>(data & (3 << 14));
+	}
+
+	[[nodiscard]] constexpr PieceType promotion_type() const {
+		return static_cast<PieceType>(((data >> 12) & 3) + KNIGHT);
+	}
+
+	[[nodiscard]] constexpr uint16_t raw() const {
+		return data;
+	}
+
+	[[nodiscard]] constexpr bool is_ok() const {
+		return from() != to();
+	}
+
+	[[nodiscard]] std::string to_string() const {
+		if (!is_ok()) return "0000";
+
+		std::string str{
+			static_cast<char>('a' + bitboard::file_of(from())),
+			static_cast<char>('8' - bitboard::row_of(from())),
+			static_cast<char>('a' + bitboard::file_of(to())),
+			static_cast<char>('8' - bitboard::row_of(to())),
+		};
+
+		if (flag() == PROMOTION) str += "nbrq"[promotion_type() - KNIGHT];
+		return str;
+	}
+
+	static constexpr Move none() {
+		return Move(0);
+	}
+
+	constexpr bool operator==(const Move &other) const = default;
+
+private:
+	uint16_t data;
+};
+
+static_assert(sizeof(Move) == 2);
+
+struct ScoredMove {
+	Move	move;
+	int32_t score;
+};
+
+constexpr size_t MAX_MOVES = 256;
+
+// Fixed-capacity move container living entirely on the stack. Capacity covers the largest number of legal
+// moves in any reachable position (218), so pushes are unchecked.
+template <size_t Capacity = MAX_MOVES>
+class MoveList final {
+public:
+	MoveList()
+		: count(0) {
+	}
+
+	void push(Move m, int32_t score = 0) {
+		moves[count++] = {m, score};
+	}
+
+	void clear() {
+		count = 0;
+	}
+
+	// Drops every move past the first `n`; used to filter a list in place.
+	void resize(size_t n) {
+		count = n;
+	}
+
+	[[nodiscard]] size_t size() const {
+		return count;
+	}
+
+	[[nodiscard]] bool empty() const {
+		return count == 0;
+	}
+
+	[[nodiscard]] bool contains(Move m) const {
+		return std::any_of(begin(), end(), [m](const ScoredMove &sm) {
+			return sm.move == m;
+		});
+	}
+
+	ScoredMove &operator[](size_t i) {
+		return moves[i];
+	}
+
+	const ScoredMove &operator[](size_t i) const {
+		return moves[i];
+	}
+
+	ScoredMove *begin() {
+		return moves.data();
+	}
+
+	ScoredMove *end() {
+		return moves.data() + count;
+	}
+
+	[[nodiscard]] const ScoredMove *begin() const {
+		return moves.data();
+	}
+
+	[[nodiscard]] const ScoredMove *end() const {
+		return moves.data() + count;
+	}
+
+	// Orders the whole list, best score first. Equal scores keep their generation order. An insertion sort:
+	// stable without the buffer std::stable_sort allocates, and quick on lists this short.
+	void sort() {
+		for (size_t i = 1; i < count; i++) {
+			ScoredMove sm = moves[i];
+			size_t	   j  = i;
+
+			for (; j > 0 && moves[j - 1].score < sm.score; j--) moves[j] = moves[j - 1];
+			moves[j] = sm;
+		}
+	}
+
+	// One selection sort step: brings the best move of [i, size()) to index i and returns it. Searches
+	// usually cut off after a few moves, so this beats sorting the whole list up front.
+	ScoredMove &pick(size_t i) {
+		ScoredMove *best = std::max_element(begin() + i, end(), [](const ScoredMove &a, const ScoredMove &b) {
+			return a.score < b.score;
+		});
+
+		std::swap(*best, moves[i]);
+		return moves[i];
+	}
+
+private:
+	std::array<ScoredMove, Capacity> moves;
+	size_t							 count;
+};
+
+}  // namespace app::game
+
+#endif	// CHESS_INCLUDE_GAME_MOVE_HPP
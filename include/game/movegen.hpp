@@ -0,0 +1,27 @@
+#ifndef CHESS_INCLUDE_GAME_MOVEGEN_HPP
+#define CHESS_INCLUDE_GAME_MOVEGEN_HPP
+
+#include <cstdint>
+
+#include "game/game.hpp"
+#include "game/move.hpp"
+
+namespace app::game {
+
+enum GenType {
+	CAPTURES,	   // captures and promotions
+	QUIETS,		   // everything else, castling included
+	EVASIONS,	   // check evasions, only valid while in check
+	NON_EVASIONS,  // captures and quiets, only valid while not in check
+	LEGAL,		   // legal moves, whatever the position
+};
+
+// Pseudo-legal moves of the requested kind for the side to move, except LEGAL which is fully filtered.
+template <GenType Type>
+void	 generate(const Board &board, MoveList<> &list);
+
+uint64_t perft(Board &board, int depth);
+
+}  // namespace app::game
+
+#endif	// CHESS_INCLUDE_GAME_MOVEGEN_HPP
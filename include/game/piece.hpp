@@ -11,6 +11,31 @@
 
 namespace app::game {
 
+enum Color : uint8_t {
+	BLACK,
+	WHITE,
+};
+
+enum PieceType : uint8_t {
+	PAWN,
+	KNIGHT,
+	BISHOP,
+	ROOK,
+	QUEEN,
+	KING,
+};
+
+constexpr size_t  COLOR_NB	  = 2;
+constexpr size_t  PIECE_TYPE_NB = 6;
+constexpr size_t  PIECE_NB	  = COLOR_NB * PIECE_TYPE_NB;
+
+// Piece ids are `color * PIECE_TYPE_NB + type`, matching the order of PieceKind::ALL_PIECE_KINDS.
+constexpr uint8_t NO_PIECE	  = PIECE_NB;
+
+constexpr Color operator~(Color c) {
+	return static_cast<Color>(c ^ WHITE);
+}
+
 class PieceKind final {
 public:
 	using Coord = app::game::coord::Notation;
@@ -34,11 +59,20 @@ public:
 	static const std::vector<PieceKind>						ALL_PIECE_KINDS;
 
 private:
-	PieceKind(std::string name, bool is_white, std::string algebraic_name, MoveChecker checker = nullptr);
+	PieceKind(std::string name,
+		bool			  is_white,
+		PieceType		  type,
+		std::string		  algebraic_name,
+		MoveChecker		  checker = nullptr);
 
 public:
 	[[nodiscard]] std::string			get_name() const;
 	[[nodiscard]] bool					is_white() const;
+	[[nodiscard]] Color					get_color() const;
+	[[nodiscard]] PieceType				get_type() const;
+	[[nodiscard]] uint8_t				get_id() const;
+
+	static const PieceKind			   &from_id(uint8_t id);
 	[[nodiscard]] std::string			get_algebraic_name() const;
 	[[nodiscard]] std::filesystem::path get_sprite_path() const;
 
@@ -48,6 +82,7 @@ public:
 private:
 	std::string _name;
 	bool		_is_white;
+	PieceType	_type;
 	std::string _algebraic_name;
 	MoveChecker _checker;
 
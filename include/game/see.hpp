@@ -0,0 +1,35 @@
+#ifndef CHESS_INCLUDE_GAME_SEE_HPP
+#define CHESS_INCLUDE_GAME_SEE_HPP
+
+#include <array>
+
+#include "game/bitboard.hpp"
+#include "game/game.hpp"
+#include "game/move.hpp"
+
+namespace app::game {
+
+constexpr std::array<int, PIECE_TYPE_NB> SEE_VALUES{100, 300, 300, 500, 900, 10000};
+
+// Static exchange evaluation of the piece on `from` capturing on `to`: the material balance, from the
+// capturing side's point of view, once both sides have played out every profitable recapture.
+// En passant and promotions are not modelled.
+[[nodiscard]] int				 see(const Board &board, bitboard::Square from, bitboard::Square to);
+
+// Cheaper variant used for pruning: true when see(board, from, to) >= threshold.
+[[nodiscard]] bool				 see_ge(const Board &board, bitboard::Square from, bitboard::Square to, int threshold);
+
+inline int see(const Board &board, Move m) {
+	return see(board, m.from(), m.to());
+}
+
+inline bool see_ge(const Board &board, Move m, int threshold) {
+	return see_ge(board, m.from(), m.to(), threshold);
+}
+
+// Pieces of color `c` (kings excluded) that the opponent can win material against by capturing.
+[[nodiscard]] bitboard::Bitboard hanging_pieces(const Board &board, Color c);
+
+}  // namespace app::game
+
+#endif	// CHESS_INCLUDE_GAME_SEE_HPP
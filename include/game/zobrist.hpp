@@ -0,0 +1,64 @@
+#ifndef CHESS_INCLUDE_GAME_ZOBRIST_HPP
+#define CHESS_INCLUDE_GAME_ZOBRIST_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "game/bitboard.hpp"
+#include "game/piece.hpp"
+
+namespace app::game::zobrist {
+
+namespace detail {
+
+// splitmix64, run at compile time so the keys cost nothing at startup and never change between builds.
+constexpr uint64_t splitmix(uint64_t &state) {
+	uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+	z		   = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z		   = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+struct Keys {
+	std::array<std::array<uint64_t, bitboard::SQUARE_NB>, PIECE_NB> psq;
+	std::array<uint64_t, 16>										castling;
+	std::array<uint64_t, 8>											en_passant;
+	uint64_t														side;
+};
+
+constexpr Keys make_keys() {
+	Keys	 keys{};
+	uint64_t state = 0x2545F4914F6CDD1DULL;
+
+	for (auto &piece : keys.psq)
+		for (auto &key : piece) key = splitmix(state);
+	for (auto &key : keys.castling) key = splitmix(state);
+	for (auto &key : keys.en_passant) key = splitmix(state);
+	keys.side = splitmix(state);
+
+	return keys;
+}
+
+constexpr Keys KEYS = make_keys();
+
+}  // namespace detail
+
+constexpr uint64_t psq(uint8_t piece, bitboard::Square s) {
+	return detail::KEYS.psq[piece][s];
+}
+
+constexpr uint64_t castling(uint8_t rights) {
+	return detail::KEYS.castling[rights];
+}
+
+constexpr uint64_t en_passant(bitboard::Square s) {
+	return detail::KEYS.en_passant[bitboard::file_of(s)];
+}
+
+constexpr uint64_t side() {
+	return detail::KEYS.side;
+}
+
+}  // namespace app::game::zobrist
+
+#endif	// CHESS_INCLUDE_GAME_ZOBRIST_HPP
@@ -0,0 +1,44 @@
+#ifndef CHESS_INCLUDE_GRAPHICS_ATLAS_HPP
+#define CHESS_INCLUDE_GRAPHICS_ATLAS_HPP
+
+#include <SDL.h>
+
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace graphics {
+
+// Sprites packed into a grid on a single texture, uploaded once. Any number of them is then drawn with one
+// SDL_RenderGeometry call.
+class SpriteAtlas final {
+public:
+	struct Sprite {
+		size_t	  index;
+		SDL_Rect  dst;
+		// Multiplied with the sprite's pixels, white draws them unchanged.
+		SDL_Color color = {255, 255, 255, SDL_ALPHA_OPAQUE};
+	};
+
+	SpriteAtlas(const std::shared_ptr<SDL_Renderer> &renderer, const std::vector<SDL_Surface *> &surfaces);
+
+	SpriteAtlas(const SpriteAtlas &)			= delete;
+	SpriteAtlas &operator=(const SpriteAtlas &) = delete;
+	SpriteAtlas(SpriteAtlas &&) noexcept		= default;
+	SpriteAtlas &operator=(SpriteAtlas &&)		= default;
+
+	~SpriteAtlas()								= default;
+
+	void				 draw(const std::shared_ptr<SDL_Renderer> &renderer, std::span<const Sprite> sprites) const;
+
+	[[nodiscard]] size_t size() const;
+
+private:
+	std::shared_ptr<SDL_Texture> texture;
+	// Texture coordinates of each sprite, normalized to the atlas size.
+	std::vector<SDL_FRect>		 cells;
+};
+
+}  // namespace graphics
+
+#endif	// CHESS_INCLUDE_GRAPHICS_ATLAS_HPP
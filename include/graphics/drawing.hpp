@@ -0,0 +1,52 @@
+#ifndef CHESS_INCLUDE_GRAPHICS_DRAWING_HPP
+#define CHESS_INCLUDE_GRAPHICS_DRAWING_HPP
+
+#include <SDL.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "game/game.hpp"
+#include "graphics/atlas.hpp"
+#include "graphics/glyphs.hpp"
+#include "graphics/window.hpp"
+#include "resources.hpp"
+
+// Board drawing on any renderer, shared by the window and the headless diagram renderer. The board's top left
+// corner is at the origin and its squares are `case_size` pixels wide.
+namespace graphics::game {
+
+// A position as drawn, copied out of a game board so that it can be drawn on another thread.
+struct Position {
+	std::array<uint8_t, app::game::bitboard::SQUARE_NB> pieces;
+	bool												 flipped;
+
+	Position();
+	explicit Position(const app::game::Board &board);
+};
+
+// One image per piece, indexed by piece id.
+typedef std::vector<std::shared_ptr<app::resources::Image> > PieceSprites;
+
+[[nodiscard]] PieceSprites	load_piece_sprites(size_t size);
+// Building the atlas changes the blend mode of the sprite surfaces for a moment: one at a time.
+[[nodiscard]] SpriteAtlas	make_piece_atlas(const std::shared_ptr<SDL_Renderer> &renderer,
+						   const PieceSprites						&sprites);
+
+[[nodiscard]] size_t		piece_size(int case_size);
+[[nodiscard]] size_t		label_font_size(int case_size);
+[[nodiscard]] window::Coord sprite_coord(int case_size, size_t x, size_t y);
+
+void						draw_squares(const std::shared_ptr<SDL_Renderer> &renderer, int case_size);
+void						draw_labels(const std::shared_ptr<SDL_Renderer> &renderer, const GlyphAtlas &glyphs,
+						   int case_size, bool flipped);
+
+// Sprites of every piece except the one on `skip`, indexed by piece id as in the piece atlas.
+void						add_piece_sprites(const Position &position, int case_size,
+							   std::vector<SpriteAtlas::Sprite> &sprites,
+							   app::game::bitboard::Square		 skip = app::game::bitboard::NO_SQUARE);
+
+}  // namespace graphics::game
+
+#endif	// CHESS_INCLUDE_GRAPHICS_DRAWING_HPP
@@ -1,36 +1,62 @@
 #ifndef CHESS_INCLUDE_GRAPHICS_HPP
 #define CHESS_INCLUDE_GRAPHICS_HPP
 
+#include <future>
 #include <optional>
+#include <string_view>
 
 #include "app.hpp"
 #include "game/game.hpp"
 #include "game/piece.hpp"
+#include "graphics/atlas.hpp"
+#include "graphics/drawing.hpp"
+#include "graphics/glyphs.hpp"
+#include "graphics/window.hpp"
+#include "resources.hpp"
+#include "utils.hpp"
 
 namespace graphics::game {
 
+// What the render thread needs to draw the board, copied from the game state on the main thread.
+struct Frame {
+	Position							 position;
+	int									 case_size = 0;
+	app::game::bitboard::Bitboard		 checked   = 0;
+	app::game::bitboard::Bitboard		 hanging   = 0;
+	// Drawn above the other pieces, already kept inside the window.
+	std::optional<SpriteAtlas::Sprite>	 dragged;
+	std::shared_ptr<const PieceSprites>	 sprites;
+	// Bumped when the background has to be drawn again although nothing it depends on changed.
+	unsigned							 background_epoch = 0;
+	// How the game ended, empty while it goes on. Points to a string literal.
+	std::string_view					 outcome;
+};
+
+// Game state and input, on the main thread.
 class Board {
 public:
 	Board(graphics::window::Window &window, bool empty);
 
-	void			   update();
-	void			   draw() const;
+	void				  update();
+	[[nodiscard]] Frame	  snapshot() const;
 
-	void			   flip();
+	void				  flip();
+	void				  toggle_hints();
+	void				  invalidate_background();
 
-	void			   select(size_t x, size_t y);
-	[[nodiscard]] bool has_selected() const;
-	void			   move_pointer_piece(int x, int y);
-	void			   drop_selected(size_t x, size_t y);
+	void				  select(size_t x, size_t y);
+	[[nodiscard]] bool	  has_selected() const;
+	void				  move_pointer_piece(int x, int y);
+	void				  drop_selected(size_t x, size_t y);
 
 private:
 	using PieceKind = app::game::PieceKind;
 
-	typedef std::unordered_map<app::game::PieceKind, graphics::ImageRenderer> PieceRenderers;
-
-	struct PreRenderedBoardText {
-		std::vector<graphics::TextRenderer> numbers;
-		std::vector<graphics::TextRenderer> letters;
+	// Sprites being rasterized in the background for a new piece size.
+	struct PendingSprites {
+		size_t					  size;
+		std::future<PieceSprites> images;
+		std::future<void>		  task;
 	};
 
 	struct SelectedPiece {
@@ -43,23 +69,71 @@ private:
 		bool			 moved;
 	};
 
-	void								  draw_pieces() const;
-	void								  draw_chessboard() const;
-	void								  draw_selected() const;
+	void								  refresh_hints();
 
-	void								  check_pre_rendered(const std::shared_ptr<SDL_Renderer> &renderer);
-	void								  init_piece_renderers();
+	void								  check_layout();
+	void								  check_piece_images();
 	[[nodiscard]] graphics::window::Coord gen_sprite_coord(size_t x, size_t y) const;
 	[[nodiscard]] size_t				  get_piece_size() const;
+	[[nodiscard]] bool					  on_board(size_t x, size_t y) const;
 
 	graphics::window::Window			 &win;
 	app::game::Board					  board;
-	const int							  case_size;
+	int									  case_size;
+	std::pair<size_t, size_t>			  layout_size;
 
 	std::optional<SelectedPiece>		  selected;
-	PieceRenderers						  piece_renderers;
+	// Until the sprites of a new size are ready, the old ones are drawn scaled.
+	std::shared_ptr<const PieceSprites>	  piece_images;
+	size_t								  sprite_size;
+	std::optional<PendingSprites>		  pending_sprites;
+
+	bool								  show_hints;
+	app::game::bitboard::Bitboard		  hanging;
+	unsigned							  background_epoch;
+	// Once set, pieces can no longer be picked up.
+	std::string_view					  outcome;
+};
+
+// Draws frames on the render thread, owning everything tied to the renderer.
+class BoardView {
+public:
+	void draw(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame);
+
+private:
+	// Squares and coordinates, drawn once into a texture for the current renderer and layout.
+	struct CachedBackground {
+		std::shared_ptr<SDL_Renderer> renderer;
+		int							  case_size;
+		bool						  flipped;
+		unsigned					  epoch;
+		std::shared_ptr<SDL_Texture>  texture;
+	};
+
+	struct CachedGlyphs {
+		std::shared_ptr<SDL_Renderer> renderer;
+		int							  case_size;
+		std::optional<GlyphAtlas>	  atlas;
+	};
+
+	struct CachedPieces {
+		std::shared_ptr<SDL_Renderer>		renderer;
+		std::shared_ptr<const PieceSprites> sprites;
+		std::optional<SpriteAtlas>			atlas;
+	};
+
+	void			 draw_background(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame) const;
+	void			 draw_hints(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame) const;
+	void			 draw_pieces(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame) const;
+	void			 draw_outcome(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame) const;
+
+	void			 check_label_glyphs(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame);
+	void			 check_background(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame);
+	void			 check_piece_atlas(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame);
 
-	std::pair<std::shared_ptr<SDL_Renderer>, PreRenderedBoardText> preRenderedBoardText;
+	CachedGlyphs	 label_glyphs;
+	CachedBackground background;
+	CachedPieces	 piece_atlas;
 };
 
 class Chess final : public app::Application {
@@ -72,13 +146,16 @@ public:
 	explicit Chess(graphics::window::Window &window);
 
 protected:
-	void draw() const override;
+	void draw() override;
 	void update() override;
 	void handle_events(const SDL_Event &e) override;
+	void release_renderer() override;
 
 private:
-	Board					  board;
-	graphics::window::Window &win;
+	Board					   board;
+	BoardView				   view;
+	utils::TripleBuffer<Frame> frames;
+	graphics::window::Window  &win;
 };
 
 }  // namespace graphics::game
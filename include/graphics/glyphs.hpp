@@ -0,0 +1,60 @@
+#ifndef CHESS_INCLUDE_GRAPHICS_GLYPHS_HPP
+#define CHESS_INCLUDE_GRAPHICS_GLYPHS_HPP
+
+#include <SDL.h>
+
+#include <array>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+#include "graphics/atlas.hpp"
+#include "graphics/window.hpp"
+#include "resources.hpp"
+
+namespace graphics {
+
+// Printable ASCII glyphs of one font at one size, rasterized once into a sprite atlas. Any number of strings,
+// changing every frame or not, is then drawn with one batched call and no texture creation.
+class GlyphAtlas final {
+public:
+	struct Text {
+		std::string_view content;
+		int				 x;
+		int				 y;
+		Color			 color;
+	};
+
+	GlyphAtlas(const std::shared_ptr<SDL_Renderer> &renderer, const std::filesystem::path &font, size_t font_size);
+
+	GlyphAtlas(const GlyphAtlas &)			  = delete;
+	GlyphAtlas &operator=(const GlyphAtlas &) = delete;
+	GlyphAtlas(GlyphAtlas &&) noexcept		  = default;
+	GlyphAtlas &operator=(GlyphAtlas &&)	  = default;
+
+	~GlyphAtlas()							  = default;
+
+	void								   draw(const std::shared_ptr<SDL_Renderer> &renderer, std::span<const Text> texts) const;
+
+	[[nodiscard]] std::pair<int, int>	   measure(std::string_view content) const;
+
+private:
+	static constexpr char				   FIRST_GLYPH = ' ';
+	static constexpr char				   LAST_GLYPH  = '~';
+	static constexpr size_t				   GLYPH_NB	   = LAST_GLYPH - FIRST_GLYPH + 1;
+
+	// Characters outside the atlas are drawn as '?'.
+	[[nodiscard]] static size_t			   glyph_index(char c);
+
+	SpriteAtlas							   rasterize(const std::shared_ptr<SDL_Renderer> &renderer);
+
+	std::shared_ptr<app::resources::Font>  font;
+	std::array<SDL_Point, GLYPH_NB>		   sizes;
+	std::array<int, GLYPH_NB>			   advances;
+	int									   line_skip;
+	SpriteAtlas							   atlas;
+};
+
+}  // namespace graphics
+
+#endif	// CHESS_INCLUDE_GRAPHICS_GLYPHS_HPP
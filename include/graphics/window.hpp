@@ -4,9 +4,13 @@
 #include <SDL.h>
 
 #include <array>
+#include <atomic>
 #include <exception>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "app.hpp"
 
@@ -21,6 +25,15 @@ struct Coord final {
 	size_t y;
 };
 
+// Time from an input event to the present of the first frame showing it, in milliseconds.
+struct LatencyStats {
+	size_t frames;
+	Uint32 p50;
+	Uint32 p90;
+	Uint32 p99;
+	Uint32 max;
+};
+
 class Window final {
 public:
 	Window()						  = delete;
@@ -37,13 +50,31 @@ public:
 	void									  run();
 	void									  bind_app(std::unique_ptr<::app::Application> app_obj);
 
+	// Drawable size in pixels, larger than the window size on high-DPI displays. Mouse events are converted to
+	// pixels before they reach the application.
 	[[nodiscard]] std::pair<size_t, size_t>	  size() const;
 
+	// Only usable from the thread drawing the application, which owns the renderer.
 	[[nodiscard]] std::weak_ptr<SDL_Renderer> get_renderer();
 
 	void									  quit();
 
+	// Schedules a new frame. The loop otherwise sleeps until an event arrives. Safe to call from any thread.
+	void									  request_redraw();
+
+	// Only meaningful once run() returned.
+	[[nodiscard]] LatencyStats				  latency() const;
+
 private:
+	void										  refresh_size();
+	void										  to_pixels(SDL_Event &e) const;
+	void										  gather_events();
+	void										  coalesce_motion();
+	void										  render_loop();
+	void										  create_renderer();
+	void										  render_frame();
+	void										  release_renderer();
+
 	struct SDLWindowDeleter {
 		void operator()(SDL_Window *win) const;
 	};
@@ -59,7 +90,28 @@ private:
 	std::string									  name;
 	uint32_t									  w;
 	uint32_t									  h;
-	bool										  should_quit;
+	uint32_t									  pixel_w;
+	uint32_t									  pixel_h;
+	std::atomic<bool>							  should_quit;
+
+	std::atomic<bool>							  dirty;
+	Uint32										  redraw_event;
+
+	// Set by the main loop when a new frame was published, cleared by the render thread when it takes it.
+	std::atomic<bool>							  frame_pending;
+	// A frame is being drawn while they differ.
+	std::atomic<uint64_t>						  published_frames;
+	std::atomic<uint64_t>						  drawn_frames;
+	// Held while pumping events and while drawing.
+	std::mutex									  sdl_mutex;
+	std::thread									  render_thread;
+	std::exception_ptr							  render_error;
+
+	std::vector<SDL_Event>						  events;
+	// SDL timestamp of the oldest input not presented yet, 0 if none.
+	std::atomic<Uint32>							  pending_input;
+	// Written by the render thread only.
+	std::vector<Uint32>							  latencies;
 };
 }  // namespace window
 
@@ -87,6 +139,8 @@ public:
 
 	static const Color	  LIGHT_SQUARE;
 	static const Color	  DARK_SQUARE;
+	static const Color	  HANGING_PIECE;
+	static const Color	  KING_IN_CHECK;
 
 	void				  rgba(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
 	void				  rgb(uint8_t r, uint8_t g, uint8_t b);
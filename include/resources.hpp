@@ -5,7 +5,10 @@
 #include <SDL_ttf.h>
 
 #include <filesystem>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "utils.hpp"
 
@@ -16,6 +19,15 @@ concept Resource = requires(T t) {
 	{ T::get_subroot() } -> std::convertible_to<std::filesystem::path>;
 };
 
+struct ResourceStats {
+	size_t loads;
+	size_t hits;
+	// Resources still referenced somewhere, and the memory they hold.
+	size_t alive;
+	size_t bytes;
+};
+
+// Identical requests, same path and same arguments, share one loaded resource for as long as it is referenced.
 template <Resource R>
 class ResourceManager final : public utils::Singleton<ResourceManager<R> > {
 public:
@@ -24,7 +36,43 @@ public:
 
 	template <class... Args>
 	std::shared_ptr<R> make(const std::filesystem::path &path, Args &&...args) const {
-		return std::make_shared<R>(root / R::get_subroot() / path, args...);
+		auto			   full = root / R::get_subroot() / path;
+
+		std::ostringstream oss;
+		oss << full.string();
+		((oss << '\0' << +args), ...);
+		std::string key = oss.str();
+
+		{
+			std::scoped_lock guard(lock);
+			if (auto resource = find(key)) return resource;
+		}
+
+		// Loaded without the lock so that different resources load in parallel; a concurrent load of the same
+		// one keeps whichever finished first.
+		auto			 loaded = std::make_shared<R>(full, args...);
+
+		std::scoped_lock guard(lock);
+		if (auto resource = find(key)) return resource;
+
+		std::erase_if(cache, [](const auto &item) { return item.second.expired(); });
+		cache[key] = loaded;
+		loads++;
+		return loaded;
+	}
+
+	[[nodiscard]] ResourceStats stats() const {
+		std::scoped_lock guard(lock);
+		ResourceStats	 result{loads, hits, 0, 0};
+
+		for (const auto &[key, weak] : cache) {
+			if (auto resource = weak.lock()) {
+				result.alive++;
+				result.bytes += resource->memory_usage();
+			}
+		}
+
+		return result;
 	}
 
 	~ResourceManager() override = default;
@@ -32,7 +80,22 @@ public:
 private:
 	ResourceManager() = default;
 
-	static std::filesystem::path root;
+	// Expects the lock to be held.
+	std::shared_ptr<R> find(const std::string &key) const {
+		auto it = cache.find(key);
+		if (it == cache.end()) return nullptr;
+
+		auto resource = it->second.lock();
+		if (resource) hits++;
+		return resource;
+	}
+
+	static std::filesystem::path								root;
+
+	mutable std::mutex											lock;
+	mutable std::unordered_map<std::string, std::weak_ptr<R> > cache;
+	mutable size_t												loads = 0;
+	mutable size_t												hits  = 0;
 
 	friend utils::Singleton<ResourceManager<R> >;
 };
@@ -50,6 +113,8 @@ public:
 	   ~Font() = default;
 
 	   [[nodiscard]] std::weak_ptr<TTF_Font> get() const;
+	   // Size of the font file, FreeType's own allocations are not visible.
+	   [[nodiscard]] size_t					 memory_usage() const;
 
 	   static std::filesystem::path			 get_subroot();
 
@@ -73,6 +138,7 @@ public:
 	~Image();
 
 	[[nodiscard]] std::weak_ptr<SDL_Surface> get() const;
+	[[nodiscard]] size_t					 memory_usage() const;
 
 	static std::filesystem::path			 get_subroot();
 
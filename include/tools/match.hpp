@@ -0,0 +1,90 @@
+#ifndef CHESS_INCLUDE_TOOLS_MATCH_HPP
+#define CHESS_INCLUDE_TOOLS_MATCH_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "tools/sprt.hpp"
+#include "tools/uci_engine.hpp"
+
+namespace tools {
+
+struct MatchConfig {
+	// The first engine is the one under test: scores and Elo are from its point of view.
+	std::array<std::string, 2> commands;
+	std::vector<std::string>   options;
+
+	int64_t					   base_ms		= 10000;
+	int64_t					   inc_ms		= 100;
+	// Allowed overrun of the clock before a game is lost on time.
+	int64_t					   margin_ms	= 100;
+
+	size_t					   concurrency	= 1;
+	uint64_t				   max_games	= 1000;
+
+	// Opening positions, one FEN per line, each played twice with colors reversed. Without a file, openings
+	// are random legal moves from the start position.
+	std::string				   openings;
+	int						   random_plies = 8;
+	uint64_t				   seed			= 1;
+
+	std::optional<Sprt>		   sprt;
+
+	// Adjudication: a game is won once both engines agree on a score beyond `resign_score` for
+	// `resign_moves` moves each, and drawn once both stay within `draw_score` for `draw_moves` moves each
+	// after `draw_after` plies, or after `max_plies` plies.
+	int						   resign_score = 1000;
+	int						   resign_moves = 3;
+	int						   draw_score	= 10;
+	int						   draw_moves	= 8;
+	int						   draw_after	= 80;
+	int						   max_plies	= 400;
+};
+
+// Plays game pairs between two UCI engines on `concurrency` threads, each owning one process of each engine,
+// until the game limit or an SPRT decision.
+class Match final {
+public:
+	Match(MatchConfig match_config, std::ostream &output);
+
+	Match(const Match &)			= delete;
+	Match &operator=(const Match &) = delete;
+
+	~Match()						= default;
+
+	Score run();
+
+private:
+	enum class Outcome {
+		FIRST_WINS,
+		SECOND_WINS,
+		DRAW,
+	};
+
+	// Each worker plays whole pairs: an opening with the first engine as white, then as black.
+	void						worker();
+	Outcome						play(std::array<std::unique_ptr<UciEngine>, 2> &engines, const std::string &opening,
+									 bool first_is_white, std::string &reason);
+	[[nodiscard]] std::string	opening(uint64_t pair) const;
+	void						record(Outcome outcome, const std::string &reason);
+
+	MatchConfig					config;
+	std::ostream			   &out;
+	std::vector<std::string>	fens;
+
+	std::mutex					lock;
+	Score						score;
+	std::atomic<uint64_t>		next_pair;
+	std::atomic<bool>			stopped;
+};
+
+}  // namespace tools
+
+#endif	// CHESS_INCLUDE_TOOLS_MATCH_HPP
@@ -0,0 +1,54 @@
+#ifndef CHESS_INCLUDE_TOOLS_SPRT_HPP
+#define CHESS_INCLUDE_TOOLS_SPRT_HPP
+
+#include <cstdint>
+
+namespace tools {
+
+// Wins, losses and draws of the first engine against the second.
+struct Score {
+	uint64_t wins	= 0;
+	uint64_t losses = 0;
+	uint64_t draws	= 0;
+
+	[[nodiscard]] uint64_t games() const {
+		return wins + losses + draws;
+	}
+};
+
+// Elo difference with the half width of its 95% confidence interval.
+struct EloEstimate {
+	double elo;
+	double error;
+};
+
+[[nodiscard]] EloEstimate elo(const Score &score);
+
+// Sequential probability ratio test of H0: elo = elo0 against H1: elo = elo1, with the normal approximation
+// of the game score (the GSPRT used by most testing frameworks). The test may stop after any game.
+class Sprt final {
+public:
+	enum Decision {
+		CONTINUE,
+		ACCEPT_H0,
+		ACCEPT_H1,
+	};
+
+	Sprt(double elo0, double elo1, double alpha, double beta);
+
+	[[nodiscard]] double   llr(const Score &score) const;
+	[[nodiscard]] Decision decide(const Score &score) const;
+
+	[[nodiscard]] double   lower_bound() const;
+	[[nodiscard]] double   upper_bound() const;
+
+private:
+	double score0;
+	double score1;
+	double lower;
+	double upper;
+};
+
+}  // namespace tools
+
+#endif	// CHESS_INCLUDE_TOOLS_SPRT_HPP
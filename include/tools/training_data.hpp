@@ -0,0 +1,81 @@
+#ifndef CHESS_INCLUDE_TOOLS_TRAINING_DATA_HPP
+#define CHESS_INCLUDE_TOOLS_TRAINING_DATA_HPP
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "game/game.hpp"
+
+namespace tools {
+
+// 32 bytes per position: the occupied squares, then one nibble per occupied square (in square order) holding
+// the piece id, then the state the FEN needs, the search score and the game result. Native byte order.
+struct TrainingEntry {
+	uint64_t				occupancy;
+	std::array<uint8_t, 16> pieces;
+	// Bit 0: white to move; bits 1 to 4: castling rights.
+	uint8_t					flags;
+	uint8_t					ep_square;
+	uint8_t					rule50;
+	// Final result from white's point of view: -1, 0 or 1.
+	int8_t					result;
+	// Search score in centipawns from the side to move's point of view.
+	int16_t					score;
+	uint16_t				ply;
+};
+
+static_assert(sizeof(TrainingEntry) == 32);
+
+[[nodiscard]] TrainingEntry pack(const app::game::Board &board, int ply, int score, int result);
+[[nodiscard]] std::string	to_fen(const TrainingEntry &entry);
+
+// Appends entries to a file; whole games are written at once from any thread.
+class TrainingWriter final {
+public:
+	explicit TrainingWriter(const std::filesystem::path &path);
+
+	TrainingWriter(const TrainingWriter &)			  = delete;
+	TrainingWriter &operator=(const TrainingWriter &) = delete;
+
+	~TrainingWriter()								  = default;
+
+	void				   write(std::span<const TrainingEntry> entries);
+	[[nodiscard]] uint64_t written() const;
+
+private:
+	mutable std::mutex lock;
+	std::ofstream	   file;
+	uint64_t		   count;
+};
+
+// Sequential reader over a file written by TrainingWriter, refilling a block of entries at a time.
+class TrainingReader final {
+public:
+	explicit TrainingReader(const std::filesystem::path &path);
+
+	TrainingReader(const TrainingReader &)			  = delete;
+	TrainingReader &operator=(const TrainingReader &) = delete;
+
+	~TrainingReader()								  = default;
+
+	bool				 next(TrainingEntry &entry);
+	[[nodiscard]] size_t size() const;
+
+private:
+	static constexpr size_t	   BLOCK_SIZE = 4096;
+
+	std::ifstream			   file;
+	size_t					   total;
+	std::vector<TrainingEntry> block;
+	size_t					   position;
+};
+
+}  // namespace tools
+
+#endif	// CHESS_INCLUDE_TOOLS_TRAINING_DATA_HPP
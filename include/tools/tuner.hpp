@@ -0,0 +1,70 @@
+#ifndef CHESS_INCLUDE_TOOLS_TUNER_HPP
+#define CHESS_INCLUDE_TOOLS_TUNER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "game/evaluate.hpp"
+
+namespace tools {
+
+// One labeled position reduced to what the evaluation sees: its features and phase. 18 bytes, so tens of
+// millions of positions fit in memory and an epoch streams through them without touching a board.
+struct PackedPosition {
+	std::array<int8_t, app::game::eval::TERM_NB> features;
+	uint8_t										  phase;
+	// Game result from white's point of view, in half points: 0, 1 or 2.
+	uint8_t										  result;
+};
+
+static_assert(sizeof(PackedPosition) == app::game::eval::TERM_NB + 2);
+
+// Texel tuning: fits the evaluation weights to game results by minimizing the mean squared error between the
+// result and sigmoid(K * eval). The evaluation is linear in its weights, so the gradient is exact and cheap.
+class Tuner final {
+public:
+	// Middlegame and endgame weight of each term, as in game/eval_weights.hpp.
+	typedef std::array<std::array<double, 2>, app::game::eval::TERM_NB> Weights;
+
+	explicit Tuner(size_t thread_count);
+
+	// Reads lines holding a FEN and a result ("1-0", "0-1", "1/2-1/2", or "[1.0]", "[0.5]", "[0.0]"), or
+	// self-play positions from a .bin file (see tools/training_data.hpp).
+	// Positions in check and king and pawn versus king positions, which the evaluation does not score
+	// through its weights, are skipped. Returns the number of positions added.
+	size_t								  load(const std::filesystem::path &path);
+
+	// Scaling constant K that best fits the current weights, found by ternary search.
+	double								  fit_scaling();
+	// One full-batch Adam step; returns the error before the step.
+	double								  epoch(double learning_rate);
+	[[nodiscard]] double				  error() const;
+
+	void								  write_header(const std::filesystem::path &path) const;
+
+	[[nodiscard]] size_t				  size() const;
+	[[nodiscard]] const Weights			 &weights() const;
+
+private:
+	typedef std::array<std::array<double, 2>, app::game::eval::TERM_NB> Gradient;
+
+	[[nodiscard]] double				  error(double k) const;
+	// Runs `job(begin, end, thread)` over the positions split across the threads.
+	template <typename Job>
+	void								  parallel(size_t count, Job job) const;
+
+	size_t								  threads;
+	double								  scaling;
+	Weights								  params;
+	Gradient							  moment1;
+	Gradient							  moment2;
+	int									  steps;
+	std::vector<PackedPosition>			  positions;
+};
+
+}  // namespace tools
+
+#endif	// CHESS_INCLUDE_TOOLS_TUNER_HPP
@@ -0,0 +1,51 @@
+#ifndef CHESS_INCLUDE_TOOLS_UCI_ENGINE_HPP
+#define CHESS_INCLUDE_TOOLS_UCI_ENGINE_HPP
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace tools {
+
+// A UCI engine running as a child process, talking over its standard input and output.
+class UciEngine final {
+public:
+	typedef std::chrono::milliseconds Duration;
+
+	// Starts `command` (split on spaces, looked up in PATH) and waits for uciok.
+	explicit UciEngine(const std::string &command, Duration timeout = Duration(10000));
+
+	UciEngine(const UciEngine &)			= delete;
+	UciEngine &operator=(const UciEngine &) = delete;
+
+	~UciEngine();
+
+	void							 send(const std::string &line);
+	// Next line of output, or nothing when `timeout` expires or the engine exits.
+	std::optional<std::string>		 read_line(Duration timeout);
+	// Reads lines until one starts with `prefix`; that line is returned, the others are dropped.
+	std::optional<std::string>		 wait_for(const std::string &prefix, Duration timeout);
+
+	// Sends the options ("name=value") and waits for readyok.
+	bool							 configure(const std::vector<std::string> &options, Duration timeout);
+	bool							 new_game(Duration timeout);
+
+	[[nodiscard]] bool				 alive() const;
+	// The engine's "id name", or its command line when it gave none.
+	[[nodiscard]] const std::string &name() const;
+
+private:
+	pid_t		pid;
+	int			to_engine;
+	int			from_engine;
+	std::string buffer;
+	std::string id;
+	bool		exited;
+};
+
+}  // namespace tools
+
+#endif	// CHESS_INCLUDE_TOOLS_UCI_ENGINE_HPP
@@ -1,6 +1,9 @@
 #ifndef CHESS_INCLUDE_UTILS_HPP
 #define CHESS_INCLUDE_UTILS_HPP
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 
 namespace utils {
@@ -29,6 +32,41 @@ private:
 template <class T>
 std::shared_ptr<T> Singleton<T>::_instance = nullptr;
 
+// Hands the latest value from one producer thread to one consumer thread without locks: each side owns a slot
+// and they swap the third through an atomic index. Neither ever waits for the other, and values the consumer
+// did not get to are simply replaced.
+template <class T>
+class TripleBuffer {
+public:
+	TripleBuffer()								 = default;
+	TripleBuffer(const TripleBuffer&)			 = delete;
+	TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+	// Producer side: fill back(), then publish() it.
+	T& back() {
+		return slots[back_index];
+	}
+
+	void publish() {
+		back_index = middle.exchange(back_index | FRESH) & INDEX;
+	}
+
+	// Consumer side: the most recently published value, valid until the next call.
+	const T& latest() {
+		if (middle.load() & FRESH) front_index = middle.exchange(front_index) & INDEX;
+		return slots[front_index];
+	}
+
+private:
+	static constexpr uint8_t INDEX = 0b011;
+	static constexpr uint8_t FRESH = 0b100;
+
+	std::array<T, 3>		 slots{};
+	uint8_t					 back_index	 = 0;
+	uint8_t					 front_index = 1;
+	std::atomic<uint8_t>	 middle		 = 2;
+};
+
 }  // namespace utils
 
 #endif	// CHESS_INCLUDE_UTILS_HPP
@@ -0,0 +1,188 @@
+#include "engine/cache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace app::engine {
+
+namespace {
+
+// Records are stored in native byte order; the header rejects files written with another record layout.
+struct FileHeader {
+	char	 magic[8];
+	uint32_t record_size;
+	uint32_t reserved;
+	uint64_t count;
+};
+
+constexpr char MAGIC[8] = {'C', 'H', 'E', 'S', 'S', 'T', 'T', '1'};
+
+bool valid_header(const FileHeader &header, size_t file_size) {
+	return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.record_size == sizeof(CacheRecord) &&
+		   header.count <= (file_size - sizeof(FileHeader)) / sizeof(CacheRecord);
+}
+
+void store(const CacheRecord &r, TranspositionTable &tt) {
+	bool found;
+	tt.probe(r.key, found)
+		->save(r.key, r.value16, static_cast<Bound>(r.bound8), r.depth8, game::Move(r.move16), tt.generation());
+}
+
+}  // namespace
+
+AnalysisCache::AnalysisCache(int min_depth, size_t capacity)
+	: depth_threshold(min_depth),
+	  max_records(capacity) {
+}
+
+void AnalysisCache::record(uint64_t key, int value, Bound bound, int depth, game::Move m) {
+	if (depth < depth_threshold) return;
+
+	auto it = records.find(key);
+	if (it == records.end()) {
+		if (records.size() >= max_records && !make_room(depth)) return;
+		it = records.emplace(key, CacheRecord{}).first;
+		it->second.key = key;
+	} else if (depth < it->second.depth8) {
+		return;
+	} else if (depth == it->second.depth8 && it->second.bound8 == BOUND_EXACT && bound != BOUND_EXACT) {
+		// A bound from the same depth says less than the exact value already stored.
+		return;
+	}
+
+	CacheRecord &r = it->second;
+	if (m.is_ok() || depth > r.depth8) r.move16 = m.raw();
+	r.value16 = static_cast<int16_t>(value);
+	r.depth8  = static_cast<uint8_t>(std::min(depth, 255));
+	r.bound8  = bound;
+}
+
+// Drops the shallowest records, no deeper than `depth`, to free an eighth of the capacity at once; evicting
+// one record per insertion would mean a scan per insertion. Returns false when every record is deeper.
+bool AnalysisCache::make_room(int depth) {
+	std::array<size_t, 256> per_depth{};
+	for (const auto &[key, r] : records) per_depth[r.depth8]++;
+
+	size_t target = std::max<size_t>(1, max_records / 8);
+	size_t below  = 0;
+	int	   cutoff = 0;
+
+	// Records shallower than `cutoff` all go, then as many at `cutoff` as still needed.
+	while (cutoff < std::min(depth, 255) && below + per_depth[cutoff] < target) below += per_depth[cutoff++];
+
+	size_t at_cutoff = std::min(per_depth[cutoff], target - below);
+	if (below + at_cutoff == 0) return false;
+
+	for (auto it = records.begin(); it != records.end();) {
+		if (it->second.depth8 < cutoff || (it->second.depth8 == cutoff && at_cutoff && at_cutoff--))
+			it = records.erase(it);
+		else
+			++it;
+	}
+
+	return true;
+}
+
+// The file is mapped rather than read so that loading a large cache costs one pass over the page cache.
+size_t AnalysisCache::load(const std::filesystem::path &path, TranspositionTable &tt) {
+	std::error_code ec;
+	size_t			file_size = std::filesystem::file_size(path, ec);
+	if (ec || file_size < sizeof(FileHeader)) return 0;
+
+	const void *data = nullptr;
+
+#if defined(__unix__) || defined(__APPLE__)
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) return 0;
+
+	void *mapped = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapped == MAP_FAILED) return 0;
+
+	madvise(mapped, file_size, MADV_SEQUENTIAL);
+	data = mapped;
+#else
+	std::vector<char> buffer(file_size);
+	std::ifstream	  file(path, std::ios::binary);
+	if (!file.read(buffer.data(), static_cast<std::streamsize>(file_size))) return 0;
+	data = buffer.data();
+#endif
+
+	FileHeader header;
+	std::memcpy(&header, data, sizeof(header));
+
+	size_t count = 0;
+	if (valid_header(header, file_size)) {
+		count = header.count;
+
+		std::span<const CacheRecord> stored(
+			reinterpret_cast<const CacheRecord *>(static_cast<const char *>(data) + sizeof(FileHeader)), count);
+		for (const auto &r : stored) {
+			record(r.key, r.value16, static_cast<Bound>(r.bound8), r.depth8, game::Move(r.move16));
+			store(r, tt);
+		}
+	}
+
+#if defined(__unix__) || defined(__APPLE__)
+	munmap(mapped, file_size);
+#endif
+
+	return count;
+}
+
+void AnalysisCache::import(TranspositionTable &tt) const {
+	for (const auto &[key, r] : records) store(r, tt);
+}
+
+bool AnalysisCache::save(const std::filesystem::path &path) const {
+	std::vector<CacheRecord> sorted;
+	sorted.reserve(records.size());
+	for (const auto &[key, r] : records) sorted.push_back(r);
+	std::ranges::sort(sorted, {}, &CacheRecord::key);
+
+	FileHeader header{};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.record_size = sizeof(CacheRecord);
+	header.count	   = sorted.size();
+
+	auto tmp = path;
+	tmp		+= ".tmp";
+
+	{
+		std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char *>(sorted.data()),
+				   static_cast<std::streamsize>(sorted.size() * sizeof(CacheRecord)));
+		if (!file) return false;
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tmp, path, ec);
+	return !ec;
+}
+
+void AnalysisCache::clear() {
+	records.clear();
+}
+
+int AnalysisCache::min_depth() const {
+	return depth_threshold;
+}
+
+size_t AnalysisCache::size() const {
+	return records.size();
+}
+
+}  // namespace app::engine
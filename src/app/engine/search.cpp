@@ -0,0 +1,325 @@
+#include "engine/search.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "game/evaluate.hpp"
+#include "game/movegen.hpp"
+#include "game/see.hpp"
+
+namespace app::engine {
+
+using namespace game;
+
+namespace {
+
+constexpr int DEPTH_QS = -1;
+
+// Mate scores are stored relative to the node, not the root, so they stay valid wherever the entry is hit.
+int value_to_tt(int v, int ply) {
+	return v >= VALUE_MATE_IN_MAX_PLY ? v + ply : v <= -VALUE_MATE_IN_MAX_PLY ? v - ply : v;
+}
+
+int value_from_tt(int v, int ply) {
+	return v >= VALUE_MATE_IN_MAX_PLY ? v - ply : v <= -VALUE_MATE_IN_MAX_PLY ? v + ply : v;
+}
+
+bool is_capture(const Board &board, Move m) {
+	return board.piece_on(m.to()) != NO_PIECE || m.flag() == Move::EN_PASSANT;
+}
+
+}  // namespace
+
+Search::Search(TranspositionTable &table, AnalysisCache *analysis)
+	: tt(table),
+	  cache(analysis),
+	  stopped(false),
+	  stop_signal(false),
+	  node_count(0),
+	  optimum_ms(0),
+	  maximum_ms(0) {
+}
+
+Info Search::run(Board &board, const Limits &search_limits, const Listener &on_iteration) {
+	limits	   = search_limits;
+	start	   = Clock::now();
+	node_count = 0;
+	stopped	   = stop_signal.load();
+
+	for (auto &k : killers) k.fill(Move::none());
+	for (auto &side : history)
+		for (auto &row : side) row.fill(0);
+
+	// Without an explicit move time, spend a slice of the clock: soft target for starting an iteration,
+	// hard limit for aborting one.
+	optimum_ms = maximum_ms = limits.movetime;
+	if (!limits.movetime && limits.time[board.side_to_move()]) {
+		int64_t left  = limits.time[board.side_to_move()];
+		int64_t inc	  = limits.inc[board.side_to_move()];
+		int64_t slice = left / (limits.movestogo ? limits.movestogo + 1 : 30) + inc * 3 / 4;
+
+		optimum_ms	  = std::max<int64_t>(1, std::min(slice, left / 2));
+		maximum_ms	  = std::max<int64_t>(1, std::min(slice * 3, left * 3 / 4));
+	}
+
+	tt.new_search();
+
+	Info best{.depth = 0, .score = 0, .nodes = 0, .time_ms = 0, .hashfull = 0, .pv = {}};
+
+	MoveList<> root_moves;
+	generate<LEGAL>(board, root_moves);
+	if (root_moves.empty()) return best;
+
+	// A root result left by an earlier search, possibly from a previous session through the analysis cache,
+	// already covers the shallow iterations: resume from its depth.
+	int		 first_depth = 1;
+	bool	 found;
+	TTEntry *tte		 = tt.probe(board.key(), found);
+	if (found && tte->bound() == BOUND_EXACT &&
+		std::ranges::any_of(root_moves, [tte](const ScoredMove &sm) { return sm.move == tte->move(); }))
+		first_depth = std::min(std::max(tte->depth(), 1), limits.depth);
+
+	for (int depth = first_depth; depth <= limits.depth && depth < MAX_PLY; depth++) {
+		int score = negamax(board, -VALUE_INFINITE, VALUE_INFINITE, depth, 0);
+
+		// An aborted iteration is only trusted if it already has a move; the previous one is kept otherwise.
+		if (stopped && best.depth) break;
+
+		best.depth	  = depth;
+		best.score	  = score;
+		best.nodes	  = node_count;
+		best.time_ms  = elapsed();
+		best.hashfull = tt.hashfull();
+		best.pv.assign(pv_table[0].begin(), pv_table[0].begin() + pv_length[0]);
+		if (best.pv.empty()) best.pv.push_back(root_moves[0].move);
+
+		if (on_iteration) on_iteration(best);
+
+		if (stopped) break;
+		if (optimum_ms && elapsed() > optimum_ms / 2) break;
+		if (std::abs(score) >= VALUE_MATE_IN_MAX_PLY && VALUE_MATE - std::abs(score) <= depth) break;
+	}
+
+	return best;
+}
+
+void Search::stop() {
+	stop_signal = true;
+	stopped		= true;
+}
+
+void Search::clear_stop() {
+	stop_signal = false;
+}
+
+uint64_t Search::nodes() const {
+	return node_count;
+}
+
+int64_t Search::elapsed() const {
+	return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+}
+
+void Search::check_limits() {
+	if ((limits.nodes && node_count >= limits.nodes) || (maximum_ms && elapsed() >= maximum_ms)) stopped = true;
+}
+
+void Search::update_pv(int ply, Move m) {
+	pv_table[ply][ply] = m;
+	for (int i = ply + 1; i < pv_length[ply + 1]; i++) pv_table[ply][i] = pv_table[ply + 1][i];
+	pv_length[ply] = std::max(pv_length[ply + 1], ply + 1);
+}
+
+// TT move first, then captures by MVV-LVA with losing ones behind the quiets, killers, and quiets by history.
+void Search::score_moves(const Board &board, MoveList<> &moves, Move tt_move, int ply) const {
+	for (auto &[m, score] : moves) {
+		if (m == tt_move) {
+			score = 1 << 30;
+		} else if (is_capture(board, m) || m.flag() == Move::PROMOTION) {
+			PieceType victim = m.flag() == Move::EN_PASSANT ? PAWN : board.type_on(m.to());
+			int		  mvv	 = board.piece_on(m.to()) == NO_PIECE && m.flag() != Move::EN_PASSANT
+								   ? SEE_VALUES[m.promotion_type()]
+								   : SEE_VALUES[victim];
+
+			score			 = mvv * 16 - board.type_on(m.from());
+			score			+= see_ge(board, m, 0) ? 1 << 24 : -(1 << 24);
+		} else if (m == killers[ply][0]) {
+			score = (1 << 23) + 1;
+		} else if (m == killers[ply][1]) {
+			score = 1 << 23;
+		} else {
+			score = history[board.side_to_move()][m.from()][m.to()];
+		}
+	}
+}
+
+int Search::negamax(Board &board, int alpha, int beta, int depth, int ply) {
+	if (depth <= 0) return qsearch(board, alpha, beta, ply);
+
+	pv_length[ply] = ply;
+
+	if ((++node_count & 1023) == 0) check_limits();
+	if (stopped) return 0;
+
+	const bool root	   = ply == 0;
+	const bool pv_node = beta - alpha > 1;
+
+	if (!root) {
+		if (board.is_draw(ply)) return VALUE_DRAW;
+		if (ply >= MAX_PLY - 1) return evaluate(board);
+
+		alpha = std::max(alpha, -VALUE_MATE + ply);
+		beta  = std::min(beta, VALUE_MATE - ply - 1);
+		if (alpha >= beta) return alpha;
+	}
+
+	bool	 found;
+	TTEntry *tte	  = tt.probe(board.key(), found);
+	Move	 tt_move  = found ? tte->move() : Move::none();
+	int		 tt_value = found ? value_from_tt(tte->value(), ply) : 0;
+
+	if (!pv_node && found && tte->depth() >= depth &&
+		(tte->bound() & (tt_value >= beta ? BOUND_LOWER : BOUND_UPPER)))
+		return tt_value;
+
+	const bool in_check	   = board.in_check(board.side_to_move());
+	const int  static_eval = in_check ? -VALUE_INFINITE : evaluate(board);
+
+	// Reverse futility: far enough above beta that a shallow search will not bring it back.
+	if (!pv_node && !in_check && depth <= 6 && static_eval - 90 * depth >= beta &&
+		std::abs(beta) < VALUE_MATE_IN_MAX_PLY)
+		return static_eval;
+
+	MoveList<> moves;
+	generate<LEGAL>(board, moves);
+
+	if (moves.empty()) return in_check ? -VALUE_MATE + ply : VALUE_DRAW;
+
+	score_moves(board, moves, tt_move, ply);
+
+	int	 best_value = -VALUE_INFINITE;
+	Move best_move	= Move::none();
+
+	for (size_t i = 0; i < moves.size(); i++) {
+		Move m		 = moves.pick(i).move;
+		bool quiet	 = !is_capture(board, m) && m.flag() != Move::PROMOTION;
+
+		board.do_move(m);
+
+		bool gives_check = board.in_check(board.side_to_move());
+		int	 new_depth	 = depth - 1 + gives_check;
+		int	 value;
+
+		if (i == 0) {
+			value = -negamax(board, -beta, -alpha, new_depth, ply + 1);
+		} else {
+			// Late quiet moves are searched shallower first and only re-searched if they beat alpha.
+			int reduction = quiet && !in_check && !gives_check && depth >= 3 && i >= 3 ? 1 + (i >= 8) : 0;
+
+			value		  = -negamax(board, -alpha - 1, -alpha, new_depth - reduction, ply + 1);
+			if (value > alpha && reduction) value = -negamax(board, -alpha - 1, -alpha, new_depth, ply + 1);
+			if (value > alpha && value < beta) value = -negamax(board, -beta, -alpha, new_depth, ply + 1);
+		}
+
+		board.undo_move(m);
+
+		if (stopped) return 0;
+
+		if (value > best_value) {
+			best_value = value;
+
+			if (value > alpha) {
+				best_move = m;
+				alpha	  = value;
+				update_pv(ply, m);
+
+				if (alpha >= beta) {
+					if (quiet) {
+						if (killers[ply][0] != m) {
+							killers[ply][1] = killers[ply][0];
+							killers[ply][0] = m;
+						}
+						history[board.side_to_move()][m.from()][m.to()] += depth * depth;
+					}
+					break;
+				}
+			}
+		}
+	}
+
+	Bound bound = best_value >= beta ? BOUND_LOWER : best_move.is_ok() && pv_node ? BOUND_EXACT : BOUND_UPPER;
+	tte->save(board.key(), value_to_tt(best_value, ply), bound, depth, best_move, tt.generation());
+	if (cache) cache->record(board.key(), value_to_tt(best_value, ply), bound, depth, best_move);
+
+	return best_value;
+}
+
+int Search::qsearch(Board &board, int alpha, int beta, int ply) {
+	if ((++node_count & 1023) == 0) check_limits();
+	if (stopped) return 0;
+
+	pv_length[ply] = ply;
+
+	if (board.is_draw(ply)) return VALUE_DRAW;
+	if (ply >= MAX_PLY - 1) return evaluate(board);
+
+	bool	 found;
+	TTEntry *tte	  = tt.probe(board.key(), found);
+	int		 tt_value = found ? value_from_tt(tte->value(), ply) : 0;
+
+	if (found && tte->depth() >= DEPTH_QS && (tte->bound() & (tt_value >= beta ? BOUND_LOWER : BOUND_UPPER)))
+		return tt_value;
+
+	const bool in_check	  = board.in_check(board.side_to_move());
+	int		   best_value = -VALUE_INFINITE;
+
+	if (!in_check) {
+		best_value = evaluate(board);
+		if (best_value >= beta) return best_value;
+		alpha = std::max(alpha, best_value);
+	}
+
+	MoveList<> moves;
+	in_check ? generate<EVASIONS>(board, moves) : generate<CAPTURES>(board, moves);
+	score_moves(board, moves, found ? tte->move() : Move::none(), ply);
+
+	Move best_move	= Move::none();
+	bool any_legal	= false;
+
+	for (size_t i = 0; i < moves.size(); i++) {
+		Move m = moves.pick(i).move;
+
+		if (!board.legal(m)) continue;
+		any_legal = true;
+
+		// Captures that lose material cannot raise the stand-pat score.
+		if (!in_check && !see_ge(board, m, 0)) continue;
+
+		board.do_move(m);
+		int value = -qsearch(board, -beta, -alpha, ply + 1);
+		board.undo_move(m);
+
+		if (stopped) return 0;
+
+		if (value > best_value) {
+			best_value = value;
+
+			if (value > alpha) {
+				best_move = m;
+				alpha	  = value;
+				update_pv(ply, m);
+
+				if (alpha >= beta) break;
+			}
+		}
+	}
+
+	if (in_check && !any_legal) return -VALUE_MATE + ply;
+
+	Bound bound = best_value >= beta ? BOUND_LOWER : BOUND_UPPER;
+	tte->save(board.key(), value_to_tt(best_value, ply), bound, DEPTH_QS, best_move, tt.generation());
+
+	return best_value;
+}
+
+}  // namespace app::engine
@@ -0,0 +1,199 @@
+#include "engine/tt.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+	#include <sys/mman.h>
+#endif
+
+namespace app::engine {
+
+namespace {
+
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// Kilobytes of the mapping holding `addr` that the kernel backs with transparent huge pages.
+size_t anon_huge_kb(const void *addr) {
+	std::ifstream smaps("/proc/self/smaps");
+	std::string	  line;
+	auto		  target = reinterpret_cast<uintptr_t>(addr);
+	bool		  inside = false;
+
+	while (std::getline(smaps, line)) {
+		uintptr_t start, end;
+		char	  dash;
+
+		std::istringstream iss(line);
+		if (iss >> std::hex >> start >> dash >> end && dash == '-') {
+			inside = start <= target && target < end;
+			continue;
+		}
+
+		if (inside && line.starts_with("AnonHugePages:")) return std::strtoull(line.c_str() + 14, nullptr, 10);
+	}
+
+	return 0;
+}
+
+}  // namespace
+
+void TTEntry::save(uint64_t key, int value, Bound bound, int depth, game::Move m, uint8_t generation) {
+	auto k = static_cast<uint16_t>(key);
+
+	if (m.raw() || k != key16) move16 = m.raw();
+
+	if (bound == BOUND_EXACT || k != key16 || depth - DEPTH_ENTRY_OFFSET + 4 > depth8) {
+		key16	   = k;
+		value16	   = static_cast<int16_t>(value);
+		depth8	   = static_cast<uint8_t>(std::clamp(depth - DEPTH_ENTRY_OFFSET, 1, 255));
+		gen_bound8 = static_cast<uint8_t>(generation | bound);
+	}
+}
+
+TranspositionTable::~TranspositionTable() {
+	release();
+}
+
+// Large tables are dominated by TLB misses with 4 KB pages. Explicit huge pages (MAP_HUGETLB) need a
+// reserved pool, so when that fails the table is aligned on 2 MB and offered to transparent huge pages.
+void TranspositionTable::resize(size_t mb, size_t threads) {
+	release();
+
+	size_t requested = std::max<size_t>(mb, 1) * 1024 * 1024;
+	bytes			 = (requested + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+	void *mem		 = nullptr;
+
+#ifdef __linux__
+	mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	if (mem == MAP_FAILED) {
+		mem = nullptr;
+	} else {
+		allocation = Allocation::HUGETLB;
+	}
+#endif
+
+	if (!mem) {
+		mem = std::aligned_alloc(HUGE_PAGE_SIZE, bytes);
+		if (!mem) throw std::bad_alloc();
+
+		allocation = Allocation::ALIGNED;
+#ifdef __linux__
+		madvise(mem, bytes, MADV_HUGEPAGE);
+#endif
+	}
+
+	table		  = static_cast<Cluster *>(mem);
+	cluster_count = requested / sizeof(Cluster);
+
+	clear(threads);
+	update_page_info();
+}
+
+void TranspositionTable::release() {
+	if (!table) return;
+
+#ifdef __linux__
+	if (allocation == Allocation::HUGETLB) munmap(table, bytes);
+#endif
+	if (allocation == Allocation::ALIGNED) std::free(table);
+
+	table		  = nullptr;
+	cluster_count = 0;
+	allocation	  = Allocation::NONE;
+}
+
+// Zeroing is also the first touch of every page, so splitting it across threads spreads the page faults
+// instead of stalling one thread on all of them.
+void TranspositionTable::clear(size_t threads) {
+	threads		  = std::max<size_t>(threads, 1);
+
+	auto  *base	  = reinterpret_cast<char *>(table);
+	size_t stride = (bytes / threads + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+
+	std::vector<std::thread> workers;
+	for (size_t i = 0; i < threads && i * stride < bytes; i++) {
+		workers.emplace_back([base, i, stride, this] {
+			size_t begin = i * stride;
+			std::memset(base + begin, 0, std::min(stride, bytes - begin));
+		});
+	}
+
+	for (auto &worker : workers) worker.join();
+	gen8 = 0;
+}
+
+void TranspositionTable::update_page_info() {
+	std::ostringstream oss;
+
+	if (allocation == Allocation::HUGETLB) {
+		oss << "2 MB pages (hugetlbfs)";
+	} else if (size_t huge_mb = anon_huge_kb(table) / 1024) {
+		oss << "2 MB pages (transparent, " << huge_mb << " of " << bytes / (1024 * 1024) << " MB)";
+	} else {
+		oss << "4 KB pages";
+	}
+
+	pages = oss.str();
+}
+
+void TranspositionTable::new_search() {
+	gen8 += 4;
+}
+
+TTEntry *TranspositionTable::probe(uint64_t key, bool &found) const {
+	auto	 idx   = static_cast<size_t>((static_cast<unsigned __int128>(key) * cluster_count) >> 64);
+	TTEntry *tte   = table[idx].entries;
+	auto	 key16 = static_cast<uint16_t>(key);
+
+	for (size_t i = 0; i < CLUSTER_SIZE; i++) {
+		if (tte[i].key16 == key16 || !tte[i].depth8) {
+			tte[i].gen_bound8 = static_cast<uint8_t>(gen8 | (tte[i].gen_bound8 & 3));
+			found			  = tte[i].depth8 != 0;
+			return &tte[i];
+		}
+	}
+
+	// Replace the shallowest entry, entries from older searches counting as shallower.
+	TTEntry *replace = tte;
+	auto	 worth	 = [this](const TTEntry &e) {
+		return e.depth8 - 4 * ((256 + gen8 - e.gen_bound8) & 0xFC);
+	};
+
+	for (size_t i = 1; i < CLUSTER_SIZE; i++) {
+		if (worth(tte[i]) < worth(*replace)) replace = &tte[i];
+	}
+
+	found = false;
+	return replace;
+}
+
+uint8_t TranspositionTable::generation() const {
+	return gen8;
+}
+
+int TranspositionTable::hashfull() const {
+	int count = 0;
+
+	for (size_t i = 0; i < 1000 / CLUSTER_SIZE && i < cluster_count; i++) {
+		for (const auto &e : table[i].entries) count += e.depth8 && (e.gen_bound8 & 0xFC) == gen8;
+	}
+
+	return count * 1000 / static_cast<int>((1000 / CLUSTER_SIZE) * CLUSTER_SIZE);
+}
+
+size_t TranspositionTable::size_mb() const {
+	return cluster_count * sizeof(Cluster) / (1024 * 1024);
+}
+
+const std::string &TranspositionTable::page_info() const {
+	return pages;
+}
+
+}  // namespace app::engine
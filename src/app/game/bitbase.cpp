@@ -0,0 +1,124 @@
+#include "game/bitbase.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace app::game::bitbase {
+
+using namespace bitboard;
+
+namespace {
+
+// Pawn on files a to d and rows 1 to 6 (ranks 7 to 2): 24 placements.
+constexpr size_t MAX_INDEX = 2 * 24 * SQUARE_NB * SQUARE_NB;
+
+std::bitset<MAX_INDEX> kpk;
+
+size_t index(Color stm, Square bksq, Square wksq, Square psq) {
+	return wksq | (bksq << 6) | (stm << 12) | (file_of(psq) << 13) | ((row_of(psq) - 1) << 15);
+}
+
+enum Result : uint8_t {
+	INVALID = 0,
+	UNKNOWN = 1,
+	DRAW	= 2,
+	WIN		= 4,
+};
+
+uint8_t distance(Square a, Square b) {
+	return std::max(std::abs(file_of(a) - file_of(b)), std::abs(row_of(a) - row_of(b)));
+}
+
+struct Position {
+	Color  stm;
+	Square wksq;
+	Square bksq;
+	Square psq;
+	Result result;
+
+	explicit Position(size_t idx)
+		: stm(static_cast<Color>((idx >> 12) & 1)),
+		  wksq(static_cast<Square>(idx & 0x3F)),
+		  bksq(static_cast<Square>((idx >> 6) & 0x3F)),
+		  psq(make_square((idx >> 13) & 3, ((idx >> 15) & 7) + 1)) {
+		Square push = psq + NORTH;
+
+		if (distance(wksq, bksq) <= 1 || wksq == psq || bksq == psq ||
+			(stm == WHITE && (pawn_attacks(WHITE, psq) & square_bb(bksq))))
+			result = INVALID;
+
+		// The pawn promotes safely: the queen cannot be taken, or the king defends it.
+		else if (stm == WHITE && row_of(psq) == 1 && wksq != push && bksq != push &&
+				 (distance(bksq, push) > 1 || distance(wksq, push) == 1))
+			result = WIN;
+
+		// Stalemate, or the king takes an undefended pawn.
+		else if (stm == BLACK &&
+				 (!(king_attacks(bksq) & ~(king_attacks(wksq) | pawn_attacks(WHITE, psq))) ||
+					 (king_attacks(bksq) & ~king_attacks(wksq) & square_bb(psq))))
+			result = DRAW;
+
+		else
+			result = UNKNOWN;
+	}
+
+	// A position is won for white once one white move reaches a win, drawn for black once one black move
+	// reaches a draw; otherwise it resolves when every successor is settled the other way.
+	Result classify(const std::vector<Position> &db) const {
+		const Result good = stm == WHITE ? WIN : DRAW;
+		const Result bad  = stm == WHITE ? DRAW : WIN;
+		const Color	 them = ~stm;
+
+		uint8_t		 r	  = INVALID;
+		Bitboard	 b	  = king_attacks(stm == WHITE ? wksq : bksq);
+
+		while (b) {
+			Square s  = pop_lsb(b);
+			r		 |= stm == WHITE ? db[index(them, bksq, s, psq)].result : db[index(them, s, wksq, psq)].result;
+		}
+
+		if (stm == WHITE) {
+			if (row_of(psq) > 1) {
+				Square s  = psq + NORTH;
+				r		 |= db[index(BLACK, bksq, wksq, s)].result;
+
+				// Double push from the second rank.
+				if (row_of(psq) == 6 && s != wksq && s != bksq) r |= db[index(BLACK, bksq, wksq, s + NORTH)].result;
+			}
+		}
+
+		return r & good ? good : r & UNKNOWN ? UNKNOWN : bad;
+	}
+};
+
+}  // namespace
+
+void init() {
+	std::vector<Position> db;
+	db.reserve(MAX_INDEX);
+
+	for (size_t idx = 0; idx < MAX_INDEX; idx++) db.emplace_back(idx);
+
+	bool changed = true;
+	while (changed) {
+		changed = false;
+
+		for (auto &pos : db) {
+			if (pos.result != UNKNOWN) continue;
+
+			pos.result = pos.classify(db);
+			changed	   = changed || pos.result != UNKNOWN;
+		}
+	}
+
+	for (size_t idx = 0; idx < MAX_INDEX; idx++) kpk[idx] = db[idx].result == WIN;
+}
+
+bool probe(Square wksq, Square wpsq, Square bksq, Color stm) {
+	return kpk[index(stm, bksq, wksq, wpsq)];
+}
+
+}  // namespace app::game::bitbase
@@ -0,0 +1,255 @@
+#include "game/bitboard.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#ifdef CHESS_HAS_PEXT
+	#include <cpuid.h>
+#endif
+
+namespace app::game::bitboard {
+
+namespace detail {
+
+std::array<Magic, SQUARE_NB>						ROOK_MAGICS;
+std::array<Magic, SQUARE_NB>						BISHOP_MAGICS;
+
+std::array<std::array<Bitboard, SQUARE_NB>, SQUARE_NB> BETWEEN;
+std::array<std::array<Bitboard, SQUARE_NB>, SQUARE_NB> LINE;
+
+#ifdef CHESS_HAS_PEXT
+bool USE_PEXT = false;
+#endif
+
+}  // namespace detail
+
+namespace {
+
+using detail::Magic;
+
+constexpr std::array<std::pair<int, int>, 4> ROOK_DIRECTIONS{
+	{{1, 0}, {-1, 0}, {0, 1}, {0, -1}}
+};
+constexpr std::array<std::pair<int, int>, 4> BISHOP_DIRECTIONS{
+	{{1, 1}, {-1, 1}, {1, -1}, {-1, -1}}
+};
+
+std::array<Bitboard, 0x19000> rook_table;
+std::array<Bitboard, 0x1480>  bishop_table;
+
+SliderBackend				  backend = SliderBackend::AUTO;
+
+// xorshift64* generator; fixed seeds keep the magic search deterministic.
+class PRNG {
+public:
+	explicit PRNG(uint64_t seed)
+		: state(seed) {
+	}
+
+	uint64_t next() {
+		state ^= state >> 12;
+		state ^= state << 25;
+		state ^= state >> 27;
+		return state * 2685821657736338717ULL;
+	}
+
+	uint64_t sparse() {
+		return next() & next() & next();
+	}
+
+private:
+	uint64_t state;
+};
+
+Bitboard sliding_attacks(const std::array<std::pair<int, int>, 4> &directions, Square s, Bitboard occupied) {
+	Bitboard b = 0;
+
+	for (const auto &[dx, dy] : directions) {
+		int x = file_of(s) + dx;
+		int y = row_of(s) + dy;
+
+		while (0 <= x && x < 8 && 0 <= y && y < 8) {
+			Bitboard sq	 = square_bb(make_square(x, y));
+			b			|= sq;
+			if (occupied & sq) break;
+
+			x += dx;
+			y += dy;
+		}
+	}
+
+	return b;
+}
+
+void init_magics(const std::array<std::pair<int, int>, 4> &directions,
+	std::array<Magic, SQUARE_NB>						  &magics,
+	Bitboard											  *table,
+	bool												   use_pext) {
+	// Per-row seeds picked offline to keep the search short.
+	constexpr std::array<uint64_t, 8> seeds{728, 2985, 110, 2501, 1289, 2821, 1699, 255};
+
+	std::vector<Bitboard> occupancies;
+	std::vector<Bitboard> references;
+	std::vector<unsigned> epoch;
+	unsigned			  attempt = 0;
+
+	for (Square s = 0; s < SQUARE_NB; s++) {
+		Magic	&m	   = magics[s];
+		Bitboard edges = ((ROW_0 | ROW_7) & ~(ROW_0 << (8 * row_of(s)))) |
+						 ((FILE_A | FILE_H) & ~(FILE_A << file_of(s)));
+
+		m.mask		   = sliding_attacks(directions, s, 0) & ~edges;
+		m.shift		   = 64 - std::popcount(m.mask);
+		m.attacks	   = s == 0 ? table : magics[s - 1].attacks + (1ULL << (64 - magics[s - 1].shift));
+
+		occupancies.clear();
+		references.clear();
+
+		// Carry-Rippler enumeration of every subset of the mask.
+		Bitboard b = 0;
+		do {
+			occupancies.push_back(b);
+			references.push_back(sliding_attacks(directions, s, b));
+			b = (b - m.mask) & m.mask;
+		} while (b);
+
+#ifdef CHESS_HAS_PEXT
+		// PEXT indices are dense and collision free, no magic to search for.
+		if (use_pext) {
+			for (size_t i = 0; i < occupancies.size(); i++)
+				m.attacks[detail::pext(occupancies[i], m.mask)] = references[i];
+			continue;
+		}
+#endif
+
+		epoch.assign(occupancies.size(), 0);
+
+		PRNG rng(seeds[row_of(s)]);
+
+		for (size_t i = 0; i < occupancies.size();) {
+			do {
+				m.magic = rng.sparse();
+			} while (std::popcount((m.magic * m.mask) >> 56) < 6);
+
+			attempt++;
+			for (i = 0; i < occupancies.size(); i++) {
+				size_t idx = m.index(occupancies[i]);
+
+				if (epoch[idx] < attempt) {
+					epoch[idx]	   = attempt;
+					m.attacks[idx] = references[i];
+				} else if (m.attacks[idx] != references[i]) {
+					break;
+				}
+			}
+		}
+	}
+}
+
+void init_lines() {
+	for (Square a = 0; a < SQUARE_NB; a++) {
+		for (Square b = 0; b < SQUARE_NB; b++) {
+			if (a == b) continue;
+
+			for (PieceType pt : {BISHOP, ROOK}) {
+				if (!(attacks(pt, a, 0) & square_bb(b))) continue;
+
+				detail::LINE[a][b]	  = (attacks(pt, a, 0) & attacks(pt, b, 0)) | square_bb(a) | square_bb(b);
+				detail::BETWEEN[a][b] = attacks(pt, a, square_bb(b)) & attacks(pt, b, square_bb(a));
+			}
+		}
+	}
+}
+
+// BMI2 is there, and PEXT is not one of the microcoded implementations found on AMD before Zen 3, which
+// are slower than a magic multiplication.
+bool has_fast_pext() {
+#ifdef CHESS_HAS_PEXT
+	unsigned eax, ebx, ecx, edx;
+
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) || !(ebx & bit_BMI2)) return false;
+
+	char vendor[13] = {};
+	__get_cpuid(0, &eax, &ebx, &ecx, &edx);
+	std::memcpy(vendor, &ebx, 4);
+	std::memcpy(vendor + 4, &edx, 4);
+	std::memcpy(vendor + 8, &ecx, 4);
+
+	if (std::string_view(vendor) == "AuthenticAMD") {
+		__get_cpuid(1, &eax, &ebx, &ecx, &edx);
+		unsigned family = ((eax >> 8) & 0xF) + ((eax >> 20) & 0xFF);
+
+		return family >= 0x19;
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool has_pext() {
+#ifdef CHESS_HAS_PEXT
+	unsigned eax, ebx, ecx, edx;
+	return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & bit_BMI2);
+#else
+	return false;
+#endif
+}
+
+}  // namespace
+
+void init(SliderBackend requested) {
+	SliderBackend chosen = SliderBackend::MAGIC;
+
+	if (requested == SliderBackend::AUTO && has_fast_pext()) chosen = SliderBackend::PEXT;
+	if (requested == SliderBackend::PEXT && has_pext()) chosen = SliderBackend::PEXT;
+
+	if (chosen == backend) return;
+
+#ifdef CHESS_HAS_PEXT
+	detail::USE_PEXT = chosen == SliderBackend::PEXT;
+#endif
+
+	init_magics(ROOK_DIRECTIONS, detail::ROOK_MAGICS, rook_table.data(), chosen == SliderBackend::PEXT);
+	init_magics(BISHOP_DIRECTIONS, detail::BISHOP_MAGICS, bishop_table.data(), chosen == SliderBackend::PEXT);
+	if (backend == SliderBackend::AUTO) init_lines();
+
+	backend = chosen;
+}
+
+SliderBackend slider_backend() {
+	return backend;
+}
+
+const char *slider_backend_name() {
+	switch (backend) {
+		case SliderBackend::MAGIC:
+			return "magic";
+		case SliderBackend::PEXT:
+			return "pext";
+		default:
+			return "uninitialized";
+	}
+}
+
+Bitboard attacks(PieceType pt, Square s, Bitboard occupied) {
+	switch (pt) {
+		case KNIGHT:
+			return knight_attacks(s);
+		case BISHOP:
+			return bishop_attacks(s, occupied);
+		case ROOK:
+			return rook_attacks(s, occupied);
+		case QUEEN:
+			return queen_attacks(s, occupied);
+		case KING:
+			return king_attacks(s);
+		default:
+			throw std::invalid_argument("pawn attacks depend on color");
+	}
+}
+
+}  // namespace app::game::bitboard
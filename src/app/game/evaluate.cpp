@@ -0,0 +1,161 @@
+#include "game/evaluate.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include "game/bitbase.hpp"
+#include "game/eval_weights.hpp"
+#include "game/fill.hpp"
+
+namespace app::game {
+
+using namespace bitboard;
+
+namespace {
+
+// Files c to f on the three ranks behind the pawn front, where Us gains space.
+template <Color Us>
+constexpr Bitboard space_mask() {
+	constexpr Bitboard center_files = (FILE_A << 2) | (FILE_A << 3) | (FILE_A << 4) | (FILE_A << 5);
+	return center_files & (relative_rank_bb<Us>(1) | relative_rank_bb<Us>(2) | relative_rank_bb<Us>(3));
+}
+
+Bitboard file_fill(Bitboard b) {
+	return b | kogge_stone<NORTH>(b, ~0ULL) | kogge_stone<SOUTH>(b, ~0ULL);
+}
+
+// Features of one side, written into `trace` with the sign of Us. Attack maps are built set-wise, so the
+// mobility terms count squares reached by at least one piece of the kind rather than per-piece moves.
+template <Color Us>
+void trace_side(const Board &board, eval::Trace &trace) {
+	using namespace eval;
+
+	constexpr Color		Them	 = ~Us;
+	constexpr Direction Up		 = pawn_push<Us>();
+	constexpr Direction Down	 = pawn_push<Them>();
+	constexpr int		sign	 = Us == WHITE ? 1 : -1;
+
+	const Bitboard		occupied = board.pieces();
+	const Bitboard		pawns	 = board.pieces(Us, PAWN);
+	const Bitboard		knights	 = board.pieces(Us, KNIGHT);
+	const Bitboard		bishops	 = board.pieces(Us, BISHOP);
+	const Bitboard		rooks	 = board.pieces(Us, ROOK);
+	const Bitboard		queens	 = board.pieces(Us, QUEEN);
+	const Bitboard		king	 = board.pieces(Us, KING);
+	const Bitboard		their	 = board.pieces(Them, PAWN);
+
+	// Two passes fill all eight directions: rooks and bishops together, then queens both ways.
+	const SliderFill	sliders	 = slider_fill(rooks, bishops, occupied);
+	const SliderFill	queen	 = slider_fill(queens, queens, occupied);
+
+	const Bitboard		their_pawn_attacks = pawn_attacks_bb<Them>(their);
+	const Bitboard		area			   = ~(pawns | king | their_pawn_attacks);
+	const Bitboard		knight_attacks	   = knight_fill(knights);
+	const Bitboard		queen_attacks	   = queen.orthogonal | queen.diagonal;
+	const Bitboard		all_attacks		   = pawn_attacks_bb<Us>(pawns) | knight_attacks | sliders.diagonal |
+									sliders.orthogonal | queen_attacks | king_fill(king);
+
+	auto add = [&trace](Term t, int value) {
+		trace.features[t] += sign * value;
+	};
+
+	add(PAWN_VALUE, std::popcount(pawns));
+	add(KNIGHT_VALUE, std::popcount(knights));
+	add(BISHOP_VALUE, std::popcount(bishops));
+	add(ROOK_VALUE, std::popcount(rooks));
+	add(QUEEN_VALUE, std::popcount(queens));
+	add(BISHOP_PAIR, more_than_one(bishops));
+
+	add(KNIGHT_MOBILITY, std::popcount(knight_attacks & area));
+	add(BISHOP_MOBILITY, std::popcount(sliders.diagonal & area));
+	add(ROOK_MOBILITY, std::popcount(sliders.orthogonal & area));
+	add(QUEEN_MOBILITY, std::popcount(queen_attacks & area));
+
+	add(SPACE, std::popcount(space_mask<Us>() & ~pawns & ~their_pawn_attacks));
+
+	Bitboard their_king = board.pieces(Them, KING);
+	add(KING_ZONE_ATTACKS, std::popcount(all_attacks & (king_fill(their_king) | their_king)));
+
+	Bitboard our_zone = king_fill(king) | king;
+	add(PAWN_SHIELD, std::popcount(pawns & (shift<Up>(our_zone) | our_zone)));
+
+	// A pawn is passed when no enemy pawn stands in front of it on its own or an adjacent file.
+	Bitboard front	= kogge_stone<Down>(their, ~0ULL);
+	Bitboard passed = pawns & ~(front | shift<EAST>(front) | shift<WEST>(front));
+	while (passed) {
+		Square s	= pop_lsb(passed);
+		int	   rank = Us == WHITE ? 7 - row_of(s) : row_of(s);
+		add(PASSED_PAWN, rank);
+	}
+
+	add(DOUBLED_PAWN, std::popcount(pawns & kogge_stone<Up>(pawns, ~0ULL)));
+
+	Bitboard files = file_fill(pawns);
+	add(ISOLATED_PAWN, std::popcount(pawns & ~(shift<EAST>(files) | shift<WEST>(files))));
+
+	trace.phase += std::popcount(knights | bishops) + 2 * std::popcount(rooks) + 4 * std::popcount(queens);
+}
+
+// Bonus for a won KPK position. It stays below a bare queen so that promoting still looks like progress.
+constexpr int KPK_WIN_BONUS = 400;
+
+// Exact score for king and pawn versus king, from white's point of view: a draw, or a win that grows as
+// the pawn advances so the search keeps pushing it.
+int evaluate_kpk(const Board &board) {
+	Color  strong = board.pieces(WHITE, PAWN) ? WHITE : BLACK;
+	Square wksq	  = board.king_square(strong);
+	Square bksq	  = board.king_square(~strong);
+	Square psq	  = lsb(board.pieces(PAWN));
+	Color  stm	  = board.side_to_move();
+
+	// Mirror so that the pawn is white and on files a to d.
+	if (strong == BLACK) {
+		wksq ^= 56;
+		bksq ^= 56;
+		psq	 ^= 56;
+		stm	  = ~stm;
+	}
+
+	if (file_of(psq) >= 4) {
+		wksq ^= 7;
+		bksq ^= 7;
+		psq	 ^= 7;
+	}
+
+	if (!bitbase::probe(wksq, psq, bksq, stm)) return 0;
+
+	int score = KPK_WIN_BONUS + eval::WEIGHTS[eval::PAWN_VALUE][1] + 20 * (7 - row_of(psq));
+	return strong == WHITE ? score : -score;
+}
+
+}  // namespace
+
+eval::Trace eval::trace(const Board &board) {
+	Trace trace{};
+
+	trace_side<WHITE>(board, trace);
+	trace_side<BLACK>(board, trace);
+	trace.phase = std::min(trace.phase, PHASE_MAX);
+
+	return trace;
+}
+
+int evaluate(const Board &board) {
+	if (std::popcount(board.pieces()) == 3 && board.pieces(PAWN)) {
+		int score = evaluate_kpk(board);
+		return board.side_to_move() == WHITE ? score : -score;
+	}
+
+	eval::Trace trace = eval::trace(board);
+	int			mg = 0, eg = 0;
+
+	for (uint8_t t = 0; t < eval::TERM_NB; t++) {
+		mg += eval::WEIGHTS[t][0] * trace.features[t];
+		eg += eval::WEIGHTS[t][1] * trace.features[t];
+	}
+
+	int score = (mg * trace.phase + eg * (eval::PHASE_MAX - trace.phase)) / eval::PHASE_MAX;
+	return board.side_to_move() == WHITE ? score : -score;
+}
+
+}  // namespace app::game
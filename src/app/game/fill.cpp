@@ -0,0 +1,90 @@
+#include "game/fill.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+	#include <immintrin.h>
+
+	#define CHESS_HAS_AVX2 1
+#endif
+
+namespace app::game::bitboard {
+
+namespace {
+
+SliderFill slider_fill_scalar(Bitboard orthogonal, Bitboard diagonal, Bitboard occupied) {
+	Bitboard empty = ~occupied;
+
+	return {
+		.orthogonal = kogge_stone<NORTH>(orthogonal, empty) | kogge_stone<SOUTH>(orthogonal, empty) |
+					  kogge_stone<EAST>(orthogonal, empty) | kogge_stone<WEST>(orthogonal, empty),
+		.diagonal	= kogge_stone<NORTH_EAST>(diagonal, empty) | kogge_stone<NORTH_WEST>(diagonal, empty) |
+					  kogge_stone<SOUTH_EAST>(diagonal, empty) | kogge_stone<SOUTH_WEST>(diagonal, empty),
+	};
+}
+
+#ifdef CHESS_HAS_AVX2
+// Lanes hold {S, E, SE, SW} for left shifts and {N, W, NW, NE} for right shifts: the same shift amounts
+// {8, 1, 9, 7}, so both registers share the shift vectors and only the wrap masks differ.
+__attribute__((target("avx2"))) SliderFill slider_fill_avx2(Bitboard orthogonal,
+	Bitboard																	diagonal,
+	Bitboard																	occupied) {
+	const __m256i gen	= _mm256_set_epi64x(static_cast<long long>(diagonal), static_cast<long long>(diagonal),
+		  static_cast<long long>(orthogonal), static_cast<long long>(orthogonal));
+	const __m256i empty = _mm256_set1_epi64x(static_cast<long long>(~occupied));
+	const __m256i s1	= _mm256_set_epi64x(7, 9, 1, 8);
+	const __m256i s2	= _mm256_slli_epi64(s1, 1);
+	const __m256i s4	= _mm256_slli_epi64(s1, 2);
+
+	const auto	  not_a = static_cast<long long>(~FILE_A);
+	const auto	  not_h = static_cast<long long>(~FILE_H);
+	const __m256i left_mask	 = _mm256_set_epi64x(not_h, not_a, not_a, -1);
+	const __m256i right_mask = _mm256_set_epi64x(not_a, not_h, not_h, -1);
+
+	__m256i		  lgen = gen, rgen = gen;
+	__m256i		  lpro = _mm256_and_si256(empty, left_mask);
+	__m256i		  rpro = _mm256_and_si256(empty, right_mask);
+
+	lgen			   = _mm256_or_si256(lgen, _mm256_and_si256(lpro, _mm256_sllv_epi64(lgen, s1)));
+	rgen			   = _mm256_or_si256(rgen, _mm256_and_si256(rpro, _mm256_srlv_epi64(rgen, s1)));
+	lpro			   = _mm256_and_si256(lpro, _mm256_sllv_epi64(lpro, s1));
+	rpro			   = _mm256_and_si256(rpro, _mm256_srlv_epi64(rpro, s1));
+
+	lgen			   = _mm256_or_si256(lgen, _mm256_and_si256(lpro, _mm256_sllv_epi64(lgen, s2)));
+	rgen			   = _mm256_or_si256(rgen, _mm256_and_si256(rpro, _mm256_srlv_epi64(rgen, s2)));
+	lpro			   = _mm256_and_si256(lpro, _mm256_sllv_epi64(lpro, s2));
+	rpro			   = _mm256_and_si256(rpro, _mm256_srlv_epi64(rpro, s2));
+
+	lgen			   = _mm256_or_si256(lgen, _mm256_and_si256(lpro, _mm256_sllv_epi64(lgen, s4)));
+	rgen			   = _mm256_or_si256(rgen, _mm256_and_si256(rpro, _mm256_srlv_epi64(rgen, s4)));
+
+	__m256i attacks	   = _mm256_or_si256(_mm256_and_si256(_mm256_sllv_epi64(lgen, s1), left_mask),
+		   _mm256_and_si256(_mm256_srlv_epi64(rgen, s1), right_mask));
+
+	alignas(32) std::array<Bitboard, 4> lanes;
+	_mm256_store_si256(reinterpret_cast<__m256i *>(lanes.data()), attacks);
+
+	return {
+		.orthogonal = lanes[0] | lanes[1],
+		.diagonal	= lanes[2] | lanes[3],
+	};
+}
+
+const bool HAS_AVX2 = __builtin_cpu_supports("avx2");
+#endif
+
+}  // namespace
+
+SliderFill slider_fill(Bitboard orthogonal, Bitboard diagonal, Bitboard occupied) {
+#ifdef CHESS_HAS_AVX2
+	if (HAS_AVX2) return slider_fill_avx2(orthogonal, diagonal, occupied);
+#endif
+	return slider_fill_scalar(orthogonal, diagonal, occupied);
+}
+
+const char *fill_backend_name() {
+#ifdef CHESS_HAS_AVX2
+	if (HAS_AVX2) return "avx2";
+#endif
+	return "scalar";
+}
+
+}  // namespace app::game::bitboard
@@ -1,8 +1,8 @@
 #include "game/game.hpp"
 
-#include <SDL_ttf.h>
-
+#include <algorithm>
 #include <bit>
+#include <cmath>
 #include <iostream>
 #include <iterator>
 #include <numeric>
@@ -10,24 +10,100 @@
 #include <string>
 #include <vector>
 
-#include "graphics/text.hpp"
+#include "game/movegen.hpp"
+#include "game/zobrist.hpp"
 
 namespace app::game {
 
+using bitboard::Bitboard;
+using bitboard::Square;
+
+namespace {
+
+constexpr Square E1 = bitboard::make_square(4, 7);
+constexpr Square E8 = bitboard::make_square(4, 0);
+
+// Rights lost when a piece leaves or lands on each square.
+constexpr std::array<uint8_t, bitboard::SQUARE_NB> CASTLING_MASK = [] {
+	std::array<uint8_t, bitboard::SQUARE_NB> mask{};
+
+	mask[bitboard::make_square(0, 0)] = BLACK_OOO;
+	mask[bitboard::make_square(7, 0)] = BLACK_OO;
+	mask[E8]						  = BLACK_OO | BLACK_OOO;
+	mask[bitboard::make_square(0, 7)] = WHITE_OOO;
+	mask[bitboard::make_square(7, 7)] = WHITE_OO;
+	mask[E1]						  = WHITE_OO | WHITE_OOO;
+	return mask;
+}();
+
+// King and rook squares each right needs. A FEN may claim rights that could never be used.
+struct CastlingHome {
+	CastlingRights right;
+	Color		   color;
+	Square		   king;
+	Square		   rook;
+};
+
+constexpr CastlingHome CASTLING_HOMES[] = {
+	{WHITE_OO, WHITE, E1, bitboard::make_square(7, 7)},
+	{WHITE_OOO, WHITE, E1, bitboard::make_square(0, 7)},
+	{BLACK_OO, BLACK, E8, bitboard::make_square(7, 0)},
+	{BLACK_OOO, BLACK, E8, bitboard::make_square(0, 0)},
+};
+
+constexpr std::string_view PIECE_CHARS = "pnbrqkPNBRQK";
+
+}  // namespace
+
+InvalidFenException::InvalidFenException(const std::string &fen, const std::string &reason) {
+	std::ostringstream oss;
+
+	oss << "invalid fen \"" << fen << "\": " << reason;
+	msg = oss.str();
+}
+
+const char *InvalidFenException::what() const noexcept {
+	return msg.c_str();
+}
+
 Board::Board(bool empty)
-	: base_game_pos(false),
-	  is_flipped(false) {
+	: mailbox{},
+	  by_color{},
+	  by_type{},
+	  states(),
+	  key_history{},
+	  side(WHITE),
+	  game_ply(0),
+	  is_flipped(false),
+	  base_game_pos(false) {
+	states.reserve(1024);
+	clear();
 	if (!empty) init_board();
 }
 
+void Board::clear() {
+	by_color.fill(0);
+	by_type.fill(0);
+	mailbox.fill(NO_PIECE);
+
+	states.clear();
+	states.push_back(State{
+		.castling	= NO_CASTLING,
+		.ep_square	= bitboard::NO_SQUARE,
+		.rule50		= 0,
+		.captured	= NO_PIECE,
+		.key		= 0,
+		.check_info = {},
+	});
+	side	 = WHITE;
+	game_ply = 0;
+}
+
 void Board::init_board() {
-	for (auto &pair : boards) {
-		pair.second = 0;
-	}
+	clear();
 
 	base_game_pos = true;
 
-	uint64_t				 tmp_board;
 	static constexpr uint8_t pawn_setup			= 0b11111111;
 	static constexpr uint8_t rook_setup			= 0b10000001;
 	static constexpr uint8_t knight_setup		= 0b01000010;
@@ -41,31 +117,243 @@ void Board::init_board() {
 	static constexpr int	 white_pieces_shift = 56;
 	static constexpr int	 black_pieces_shift = 0;
 
-	tmp_board									= static_cast<uint64_t>(pawn_setup) << black_pawns_shift;
-	boards[PieceKind::BLACK_PAWN]				= tmp_board;
-	tmp_board									= static_cast<uint64_t>(pawn_setup) << white_pawns_shift;
-	boards[PieceKind::WHITE_PAWN]				= tmp_board;
+	put_pieces(PieceKind::BLACK_PAWN, static_cast<uint64_t>(pawn_setup) << black_pawns_shift);
+	put_pieces(PieceKind::WHITE_PAWN, static_cast<uint64_t>(pawn_setup) << white_pawns_shift);
+
+	put_pieces(PieceKind::BLACK_KNIGHT, static_cast<uint64_t>(knight_setup) << black_pieces_shift);
+	put_pieces(PieceKind::WHITE_KNIGHT, static_cast<uint64_t>(knight_setup) << white_pieces_shift);
+
+	put_pieces(PieceKind::BLACK_BISHOP, static_cast<uint64_t>(bishop_setup) << black_pieces_shift);
+	put_pieces(PieceKind::WHITE_BISHOP, static_cast<uint64_t>(bishop_setup) << white_pieces_shift);
+
+	put_pieces(PieceKind::BLACK_ROOK, static_cast<uint64_t>(rook_setup) << black_pieces_shift);
+	put_pieces(PieceKind::WHITE_ROOK, static_cast<uint64_t>(rook_setup) << white_pieces_shift);
+
+	put_pieces(PieceKind::WHITE_QUEEN, static_cast<uint64_t>(queen_setup) << white_pieces_shift);
+	put_pieces(PieceKind::WHITE_KING, static_cast<uint64_t>(king_setup) << white_pieces_shift);
+
+	put_pieces(PieceKind::BLACK_QUEEN, static_cast<uint64_t>(queen_setup) << black_pieces_shift);
+	put_pieces(PieceKind::BLACK_KING, static_cast<uint64_t>(king_setup) << black_pieces_shift);
+
+	State &st									= states.back();
+	st.castling									= ANY_CASTLING;
+	st.key									   ^= zobrist::castling(ANY_CASTLING);
+	key_history[game_ply & (HISTORY_SIZE - 1)]	= st.key;
+	update_check_info();
+}
+
+void Board::set_fen(const std::string &fen) {
+	std::istringstream iss(fen);
+	std::string		   placement, color, castling, ep;
+	int				   rule50 = 0, fullmove = 1;
+
+	if (!(iss >> placement >> color >> castling >> ep)) throw InvalidFenException(fen, "missing fields");
+	iss >> rule50 >> fullmove;
+
+	clear();
+	base_game_pos = false;
+
+	uint8_t x = 0, y = 0;
+	for (char c : placement) {
+		if (c == '/') {
+			if (x != 8) throw InvalidFenException(fen, "incomplete row");
+			x = 0;
+			y++;
+		} else if ('1' <= c && c <= '8') {
+			x += c - '0';
+		} else if (auto idx = PIECE_CHARS.find(c); idx != std::string_view::npos && x < 8 && y < 8) {
+			uint8_t piece = idx < PIECE_TYPE_NB ? BLACK * PIECE_TYPE_NB + idx : WHITE * PIECE_TYPE_NB + idx - 6;
+
+			put_piece(piece, bitboard::make_square(x++, y));
+		} else {
+			throw InvalidFenException(fen, std::string("unexpected character '") + c + "'");
+		}
+
+		if (x > 8) throw InvalidFenException(fen, "row overflow");
+	}
+
+	if (y != 7 || x != 8) throw InvalidFenException(fen, "expected 8 rows");
+	if (color != "w" && color != "b") throw InvalidFenException(fen, "side to move must be 'w' or 'b'");
+	if (std::popcount(pieces(WHITE, KING)) != 1 || std::popcount(pieces(BLACK, KING)) != 1)
+		throw InvalidFenException(fen, "each side needs exactly one king");
+
+	side	   = color == "w" ? WHITE : BLACK;
+
+	State &st = states.back();
+	for (char c : castling) {
+		switch (c) {
+			case 'K':
+				st.castling |= WHITE_OO;
+				break;
+			case 'Q':
+				st.castling |= WHITE_OOO;
+				break;
+			case 'k':
+				st.castling |= BLACK_OO;
+				break;
+			case 'q':
+				st.castling |= BLACK_OOO;
+				break;
+			case '-':
+				break;
+			default:
+				throw InvalidFenException(fen, "bad castling field");
+		}
+	}
+
+	// Castling moves the rook from its corner, which has to be there.
+	for (const auto &home : CASTLING_HOMES) {
+		if (!(pieces(home.color, KING) & bitboard::square_bb(home.king)) ||
+			!(pieces(home.color, ROOK) & bitboard::square_bb(home.rook)))
+			st.castling &= ~home.right;
+	}
+
+	if (ep != "-") {
+		if (ep.size() != 2 || ep[0] < 'a' || 'h' < ep[0] || (ep[1] != '3' && ep[1] != '6'))
+			throw InvalidFenException(fen, "bad en passant square");
+
+		// Only kept when a capture is actually possible, so equal positions always compare equal. The pawn that
+		// just moved has to stand in front of the square, or the capture would take nothing.
+		Square s	  = bitboard::make_square(ep[0] - 'a', '8' - ep[1]);
+		Square pawn	  = static_cast<Square>(side == WHITE ? s + bitboard::SOUTH : s + bitboard::NORTH);
+		bool   pushed = ep[1] == (side == WHITE ? '6' : '3') && piece_on(s) == NO_PIECE &&
+					  (pieces(~side, PAWN) & bitboard::square_bb(pawn));
+
+		if (pushed && (bitboard::pawn_attacks(~side, s) & pieces(side, PAWN))) st.ep_square = s;
+	}
+
+	st.rule50 = static_cast<uint8_t>(std::clamp(rule50, 0, 255));
+	game_ply  = 2 * std::max(fullmove - 1, 0) + (side == BLACK);
+
+	st.key	 ^= zobrist::castling(st.castling);
+	if (st.ep_square != bitboard::NO_SQUARE) st.key ^= zobrist::en_passant(st.ep_square);
+	if (side == BLACK) st.key ^= zobrist::side();
+	key_history[game_ply & (HISTORY_SIZE - 1)] = st.key;
+
+	update_check_info();
+}
+
+std::string Board::fen() const {
+	std::ostringstream oss;
+
+	for (uint8_t y = 0; y < 8; y++) {
+		int empty = 0;
+
+		for (uint8_t x = 0; x < 8; x++) {
+			uint8_t piece = mailbox[bitboard::make_square(x, y)];
+
+			if (piece == NO_PIECE) {
+				empty++;
+				continue;
+			}
+
+			if (empty) oss << empty;
+			empty = 0;
+			oss << PIECE_CHARS[piece / PIECE_TYPE_NB == WHITE ? 6 + piece % PIECE_TYPE_NB : piece];
+		}
+
+		if (empty) oss << empty;
+		if (y < 7) oss << '/';
+	}
+
+	const State &st = states.back();
+	oss << (side == WHITE ? " w " : " b ");
+
+	if (!st.castling) oss << '-';
+	if (st.castling & WHITE_OO) oss << 'K';
+	if (st.castling & WHITE_OOO) oss << 'Q';
+	if (st.castling & BLACK_OO) oss << 'k';
+	if (st.castling & BLACK_OOO) oss << 'q';
+
+	if (st.ep_square == bitboard::NO_SQUARE) {
+		oss << " -";
+	} else {
+		oss << ' ' << static_cast<char>('a' + bitboard::file_of(st.ep_square))
+			<< static_cast<char>('8' - bitboard::row_of(st.ep_square));
+	}
+
+	oss << ' ' << static_cast<int>(st.rule50) << ' ' << 1 + game_ply / 2;
+	return oss.str();
+}
+
+void Board::put_pieces(const PieceKind &kind, bitboard::Bitboard squares) {
+	while (squares) put_piece(kind.get_id(), bitboard::pop_lsb(squares));
+}
+
+void Board::put_piece(uint8_t piece, bitboard::Square s) {
+	bitboard::Bitboard b			  = bitboard::square_bb(s);
+
+	mailbox[s]						  = piece;
+	by_color[piece / PIECE_TYPE_NB]	 |= b;
+	by_type[piece % PIECE_TYPE_NB]	 |= b;
+	states.back().key				 ^= zobrist::psq(piece, s);
+}
+
+void Board::remove_piece(bitboard::Square s) {
+	bitboard::Bitboard b			  = bitboard::square_bb(s);
+	uint8_t			   piece		  = mailbox[s];
+
+	mailbox[s]						  = NO_PIECE;
+	by_color[piece / PIECE_TYPE_NB]	 ^= b;
+	by_type[piece % PIECE_TYPE_NB]	 ^= b;
+	states.back().key				 ^= zobrist::psq(piece, s);
+}
+
+void Board::move_piece(bitboard::Square from, bitboard::Square to) {
+	bitboard::Bitboard b			  = bitboard::square_bb(from) | bitboard::square_bb(to);
+	uint8_t			   piece		  = mailbox[from];
+
+	mailbox[from]					  = NO_PIECE;
+	mailbox[to]						  = piece;
+	by_color[piece / PIECE_TYPE_NB]	 ^= b;
+	by_type[piece % PIECE_TYPE_NB]	 ^= b;
+	states.back().key				 ^= zobrist::psq(piece, from) ^ zobrist::psq(piece, to);
+}
 
-	tmp_board									= static_cast<uint64_t>(knight_setup) << black_pieces_shift;
-	boards[PieceKind::BLACK_KNIGHT]				= tmp_board;
-	tmp_board									= static_cast<uint64_t>(knight_setup) << white_pieces_shift;
-	boards[PieceKind::WHITE_KNIGHT]				= tmp_board;
+void Board::update_check_info() {
+	using namespace bitboard;
 
-	tmp_board									= static_cast<uint64_t>(bishop_setup) << black_pieces_shift;
-	boards[PieceKind::BLACK_BISHOP]				= tmp_board;
-	tmp_board									= static_cast<uint64_t>(bishop_setup) << white_pieces_shift;
-	boards[PieceKind::WHITE_BISHOP]				= tmp_board;
+	CheckInfo &info		  = states.back().check_info;
 
-	tmp_board									= static_cast<uint64_t>(rook_setup) << black_pieces_shift;
-	boards[PieceKind::BLACK_ROOK]				= tmp_board;
-	tmp_board									= static_cast<uint64_t>(rook_setup) << white_pieces_shift;
-	boards[PieceKind::WHITE_ROOK]				= tmp_board;
+	info.attacked[WHITE]  = compute_attacks<WHITE>();
+	info.attacked[BLACK]  = compute_attacks<BLACK>();
 
-	boards[PieceKind::WHITE_QUEEN]				= static_cast<uint64_t>(queen_setup) << white_pieces_shift;
-	boards[PieceKind::WHITE_KING]				= static_cast<uint64_t>(king_setup) << white_pieces_shift;
+	for (Color us : {WHITE, BLACK}) {
+		Color them		  = ~us;
 
-	boards[PieceKind::BLACK_QUEEN]				= static_cast<uint64_t>(queen_setup) << black_pieces_shift;
-	boards[PieceKind::BLACK_KING]				= static_cast<uint64_t>(king_setup) << black_pieces_shift;
+		info.checkers[us] = 0;
+		info.pinned[us]	  = 0;
+
+		Bitboard king	  = pieces(us, KING);
+		if (!king) continue;
+
+		Square ksq		  = lsb(king);
+		info.checkers[us] = attackers_to(ksq, pieces()) & pieces(them);
+
+		Bitboard snipers  = (rook_attacks(ksq, 0) & (pieces(them, ROOK) | pieces(them, QUEEN))) |
+						   (bishop_attacks(ksq, 0) & (pieces(them, BISHOP) | pieces(them, QUEEN)));
+
+		while (snipers) {
+			Bitboard blockers = between(ksq, pop_lsb(snipers)) & pieces();
+
+			if (blockers && !more_than_one(blockers)) info.pinned[us] |= blockers & pieces(us);
+		}
+	}
+}
+
+template <Color Us>
+bitboard::Bitboard Board::compute_attacks() const {
+	using namespace bitboard;
+
+	Bitboard result = pawn_attacks_bb<Us>(pieces(Us, PAWN));
+
+	for (PieceType pt : {KNIGHT, BISHOP, ROOK, QUEEN, KING}) {
+		Bitboard b = pieces(Us, pt);
+
+		while (b) result |= attacks(pt, pop_lsb(b), pieces());
+	}
+
+	return result;
 }
 
 bool Board::flipped() const {
@@ -108,14 +396,13 @@ void Board::dump_merged_board() const {
 			std::vector<std::string> bCase{};
 			bCase.reserve(1);
 
-			for (const auto &p : boards) {
-				bool c = p.second[y * 8 + x];
+			for (const auto &kind : PieceKind::ALL_PIECE_KINDS) {
+				bool c = pieces(kind.get_color(), kind.get_type()) & bitboard::square_bb(y * 8 + x);
 
 				if (c) {
-					std::string name = p.first.get_algebraic_name();
+					std::string name = kind.get_algebraic_name();
 					if (name.empty()) name = "p";
-					if (!p.first.is_white())
-						std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+					if (!kind.is_white()) std::transform(name.begin(), name.end(), name.begin(), ::toupper);
 
 					bCase.emplace_back(name);
 				}
@@ -171,7 +458,7 @@ void Board::dump_merged_board() const {
 }
 
 void Board::dump_subboard(const PieceKind &kind) const {
-	bitboard	board	  = boards.at(kind);
+	BitSet		board	  = pieces(kind.get_color(), kind.get_type());
 
 	std::string piece_rep = kind.get_algebraic_name();
 	if (piece_rep.empty()) piece_rep = "p";
@@ -207,19 +494,37 @@ void Board::dump_subboard(const PieceKind &kind) const {
 }
 
 bool Board::is_valid() const {
-	auto acc_fn = [](size_t a, decltype(boards)::const_reference b) {
-		return a + b.second.count();
+	using namespace bitboard;
+
+	auto disjoint = [](const auto &boards) {
+		Bitboard seen = 0;
+
+		for (Bitboard b : boards) {
+			if (seen & b) return false;
+			seen |= b;
+		}
+
+		return true;
 	};
 
-	size_t	 ref = std::accumulate(boards.begin(), boards.end(), 0, acc_fn);
+	if (!disjoint(by_color) || !disjoint(by_type)) return false;
 
-	bitboard final;
+	Bitboard typed = std::accumulate(by_type.begin(), by_type.end(), Bitboard(0), std::bit_or<>());
+	if (typed != pieces()) return false;
 
-	for (const auto &p : boards) {
-		final |= p.second;
+	for (Square s = 0; s < SQUARE_NB; s++) {
+		uint8_t piece = mailbox[s];
+
+		if (piece == NO_PIECE) {
+			if (pieces() & square_bb(s)) return false;
+			continue;
+		}
+
+		const auto &kind = PieceKind::from_id(piece);
+		if (!(pieces(kind.get_color(), kind.get_type()) & square_bb(s))) return false;
 	}
 
-	return final.count() == ref;
+	return true;
 }
 
 std::optional<PieceKind> Board::at(size_t x, size_t y) const {
@@ -227,53 +532,276 @@ std::optional<PieceKind> Board::at(size_t x, size_t y) const {
 }
 
 std::optional<PieceKind> Board::at(const coord::Agnostic &c) const {
-	size_t bitboardCoord = c.y * 8 + c.x;
+	uint8_t piece = piece_on(bitboard::make_square(c.x, c.y));
 
-	for (const auto &pair : boards) {
-		if (pair.second[bitboardCoord]) {
-			return pair.first;
+	if (piece == NO_PIECE) return std::nullopt;
+	return PieceKind::from_id(piece);
+}
+
+uint8_t Board::piece_on(bitboard::Square s) const {
+	return mailbox[s];
+}
+
+bitboard::Bitboard Board::pieces() const {
+	return by_color[WHITE] | by_color[BLACK];
+}
+
+bitboard::Bitboard Board::pieces(Color c) const {
+	return by_color[c];
+}
+
+bitboard::Bitboard Board::pieces(PieceType pt) const {
+	return by_type[pt];
+}
+
+bitboard::Bitboard Board::pieces(Color c, PieceType pt) const {
+	return by_color[c] & by_type[pt];
+}
+
+bitboard::Bitboard Board::attackers_to(bitboard::Square s, bitboard::Bitboard occupied) const {
+	using namespace bitboard;
+
+	return (pawn_attacks(BLACK, s) & pieces(WHITE, PAWN)) | (pawn_attacks(WHITE, s) & pieces(BLACK, PAWN)) |
+		   (knight_attacks(s) & pieces(KNIGHT)) | (king_attacks(s) & pieces(KING)) |
+		   (bishop_attacks(s, occupied) & (pieces(BISHOP) | pieces(QUEEN))) |
+		   (rook_attacks(s, occupied) & (pieces(ROOK) | pieces(QUEEN)));
+}
+
+bitboard::Bitboard Board::checkers(Color c) const {
+	return states.back().check_info.checkers[c];
+}
+
+bitboard::Bitboard Board::pinned(Color c) const {
+	return states.back().check_info.pinned[c];
+}
+
+bitboard::Bitboard Board::attacked_by(Color c) const {
+	return states.back().check_info.attacked[c];
+}
+
+bool Board::in_check(Color c) const {
+	return states.back().check_info.checkers[c];
+}
+
+PieceType Board::type_on(bitboard::Square s) const {
+	return static_cast<PieceType>(mailbox[s] % PIECE_TYPE_NB);
+}
+
+bitboard::Square Board::king_square(Color c) const {
+	return bitboard::lsb(pieces(c, KING));
+}
+
+Color Board::side_to_move() const {
+	return side;
+}
+
+uint8_t Board::castling_rights() const {
+	return states.back().castling;
+}
+
+bitboard::Square Board::en_passant_square() const {
+	return states.back().ep_square;
+}
+
+uint8_t Board::halfmove_clock() const {
+	return states.back().rule50;
+}
+
+uint64_t Board::key() const {
+	return states.back().key;
+}
+
+// Positions can only repeat since the last irreversible move, and only with the same side to move, so the
+// scan is limited to every other key of the rule50 window.
+int Board::repetitions(int ply) const {
+	const State &st	   = states.back();
+	int			 end   = std::min<int>(st.rule50, static_cast<int>(states.size()) - 1);
+	int			 count = 0;
+
+	for (int i = 4; i <= end; i += 2) {
+		if (key_history[(game_ply - i) & (HISTORY_SIZE - 1)] != st.key) continue;
+
+		// Inside the search tree a single repetition is enough: the side that allowed it can repeat again.
+		if (i <= ply) return 2;
+		count++;
+	}
+
+	return count;
+}
+
+bool Board::is_draw(int ply) const {
+	if (states.back().rule50 >= 100) {
+		if (!in_check(side)) return true;
+
+		MoveList<> moves;
+		generate<LEGAL>(*this, moves);
+		if (!moves.empty()) return true;
+	}
+
+	return repetitions(ply) >= 2;
+}
+
+bool Board::legal(Move m) const {
+	using namespace bitboard;
+
+	const CheckInfo &info = states.back().check_info;
+	Color			 us	  = side;
+	Color			 them = ~us;
+	Square			 from = m.from();
+	Square			 to	  = m.to();
+	Square			 ksq  = king_square(us);
+
+	if (m.flag() == Move::EN_PASSANT) {
+		Square	 capsq	  = make_square(file_of(to), row_of(from));
+		Bitboard occupied = (pieces() ^ square_bb(from) ^ square_bb(capsq)) | square_bb(to);
+
+		return !(rook_attacks(ksq, occupied) & (pieces(them, ROOK) | pieces(them, QUEEN))) &&
+			   !(bishop_attacks(ksq, occupied) & (pieces(them, BISHOP) | pieces(them, QUEEN)));
+	}
+
+	if (m.flag() == Move::CASTLING) {
+		// The king is not in check here, so the cached map is exact along its path.
+		return !(between(from, to) & info.attacked[them]) && !(info.attacked[them] & square_bb(to));
+	}
+
+	if (from == ksq) {
+		if (info.attacked[them] & square_bb(to)) return false;
+
+		// The cached map still has the king blocking sliders, so re-test squares along a checking line.
+		return !info.checkers[us] || !(attackers_to(to, pieces() ^ square_bb(from)) & pieces(them));
+	}
+
+	return !(info.pinned[us] & square_bb(from)) || aligned(from, to, ksq);
+}
+
+void Board::do_move(Move m) {
+	side == WHITE ? do_move<WHITE>(m) : do_move<BLACK>(m);
+}
+
+void Board::undo_move(Move m) {
+	side == WHITE ? undo_move<BLACK>(m) : undo_move<WHITE>(m);
+}
+
+template <Color Us>
+void Board::do_move(Move m) {
+	using namespace bitboard;
+
+	constexpr Color		Them = ~Us;
+	constexpr Direction Up	 = pawn_push<Us>();
+
+	Square				from = m.from();
+	Square				to	 = m.to();
+	uint8_t				piece = mailbox[from];
+
+	states.push_back(states.back());
+	State &st = states.back();
+
+	if (st.ep_square != NO_SQUARE) st.key ^= zobrist::en_passant(st.ep_square);
+	st.key		^= zobrist::castling(st.castling) ^ zobrist::side();
+
+	st.rule50	  = std::min(st.rule50 + 1, 255);
+	st.ep_square  = NO_SQUARE;
+	st.captured	  = NO_PIECE;
+	st.castling	 &= ~(CASTLING_MASK[from] | CASTLING_MASK[to]);
+	st.key		 ^= zobrist::castling(st.castling);
+
+	if (m.flag() == Move::CASTLING) {
+		bool   king_side = to > from;
+		Square rook_from = make_square(king_side ? 7 : 0, row_of(from));
+		Square rook_to	 = make_square(king_side ? 5 : 3, row_of(from));
+
+		move_piece(from, to);
+		move_piece(rook_from, rook_to);
+	} else {
+		Square capsq = m.flag() == Move::EN_PASSANT ? static_cast<Square>(to - Up) : to;
+
+		if (mailbox[capsq] != NO_PIECE) {
+			st.captured = mailbox[capsq];
+			st.rule50	= 0;
+			remove_piece(capsq);
+		}
+
+		move_piece(from, to);
+
+		if (piece % PIECE_TYPE_NB == PAWN) {
+			st.rule50 = 0;
+
+			if (to - from == 2 * Up && (pawn_attacks(Us, from + Up) & pieces(Them, PAWN))) {
+				st.ep_square  = from + Up;
+				st.key		 ^= zobrist::en_passant(st.ep_square);
+			}
+
+			if (m.flag() == Move::PROMOTION) {
+				remove_piece(to);
+				put_piece(Us * PIECE_TYPE_NB + m.promotion_type(), to);
+			}
 		}
 	}
 
-	return std::nullopt;
+	side = Them;
+	game_ply++;
+	key_history[game_ply & (HISTORY_SIZE - 1)] = st.key;
+	update_check_info();
 }
 
-bool Board::check_static_move_validity(const PieceKind &kind,
-	const coord::Agnostic							   &origin,
-	const coord::Agnostic							   &target) const {
-	coord::Notation o(is_flipped, origin.x, origin.y);
-	coord::Notation t(is_flipped, target.x, target.y);
+template <Color Us>
+void Board::undo_move(Move m) {
+	using namespace bitboard;
+
+	constexpr Direction Up	 = pawn_push<Us>();
 
-	if (!kind(o, t)) {
-		std::cerr << "move " << kind.get_name() << " " << o.algebraic() << " to " << t.algebraic()
-				  << " invalid\n";
-		return false;
+	Square				from = m.from();
+	Square				to	 = m.to();
+	const State		   &st	 = states.back();
+
+	side					 = Us;
+
+	if (m.flag() == Move::CASTLING) {
+		bool king_side = to > from;
+
+		move_piece(to, from);
+		move_piece(make_square(king_side ? 5 : 3, row_of(from)), make_square(king_side ? 7 : 0, row_of(from)));
+	} else {
+		if (m.flag() == Move::PROMOTION) {
+			remove_piece(to);
+			put_piece(Us * PIECE_TYPE_NB + PAWN, to);
+		}
+
+		move_piece(to, from);
+
+		if (st.captured != NO_PIECE)
+			put_piece(st.captured, m.flag() == Move::EN_PASSANT ? static_cast<Square>(to - Up) : to);
 	}
 
-	return true;
+	states.pop_back();
+	game_ply--;
 }
 
+template void Board::do_move<WHITE>(Move m);
+template void Board::do_move<BLACK>(Move m);
+template void Board::undo_move<WHITE>(Move m);
+template void Board::undo_move<BLACK>(Move m);
+
 void Board::move_with_hint(const PieceKind &kind,
 	const coord::Agnostic				   &origin,
 	const coord::Agnostic				   &target) {
-	size_t target_idx = target.y * 8 + target.x;
-
-	for (auto pair : boards) {
-		if (pair.second[target_idx]) return;
-	}
+	Square from = bitboard::make_square(origin.x, origin.y);
+	Square to	= bitboard::make_square(target.x, target.y);
 
-	bitboard &board		 = boards.at(kind);
+	if (mailbox[from] != kind.get_id()) return;
 
-	size_t	  origin_idx = origin.y * 8 + origin.x;
+	MoveList<> moves;
+	generate<LEGAL>(*this, moves);
 
-	if (!board[origin_idx]) return;
+	for (const auto &[m, score] : moves) {
+		if (m.from() != from || m.to() != to) continue;
+		if (m.flag() == Move::PROMOTION && m.promotion_type() != QUEEN) continue;
 
-	if (!check_static_move_validity(kind, origin, target)) {
+		do_move(m);
 		return;
 	}
 
-	board[origin_idx] = false;
-	board[target_idx] = true;
+	std::cerr << "move " << kind.get_name() << " " << origin << " to " << target << " invalid\n";
 }
 
 }  // namespace app::game
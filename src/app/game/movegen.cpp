@@ -0,0 +1,199 @@
+#include "game/movegen.hpp"
+
+namespace app::game {
+
+using namespace bitboard;
+
+namespace {
+
+template <Direction D>
+void push_promotions(MoveList<> &list, Square to) {
+	auto from = static_cast<Square>(to - D);
+
+	for (PieceType pt : {QUEEN, ROOK, BISHOP, KNIGHT}) list.push(Move(from, to, Move::PROMOTION, pt));
+}
+
+template <Color Us, GenType Type>
+void generate_pawn_moves(const Board &board, MoveList<> &list, Bitboard target) {
+	constexpr Color		Them		 = ~Us;
+	constexpr Direction Up			 = pawn_push<Us>();
+	constexpr Direction UpRight		 = Us == WHITE ? NORTH_EAST : SOUTH_WEST;
+	constexpr Direction UpLeft		 = Us == WHITE ? NORTH_WEST : SOUTH_EAST;
+	constexpr Bitboard	Rank3		 = relative_rank_bb<Us>(2);
+	constexpr Bitboard	Rank7		 = relative_rank_bb<Us>(6);
+
+	const Bitboard		pawns		 = board.pieces(Us, PAWN);
+	const Bitboard		pawns_on_7	 = pawns & Rank7;
+	const Bitboard		pawns_not_7	 = pawns & ~Rank7;
+	const Bitboard		empty		 = ~board.pieces();
+	const Bitboard		enemies		 = Type == EVASIONS ? board.checkers(Us) : board.pieces(Them);
+
+	if constexpr (Type != CAPTURES) {
+		Bitboard single = shift<Up>(pawns_not_7) & empty;
+		Bitboard dbl	= shift<Up>(single & Rank3) & empty;
+
+		if constexpr (Type == EVASIONS) {
+			single &= target;
+			dbl	   &= target;
+		}
+
+		while (single) {
+			Square to = pop_lsb(single);
+			list.push(Move(to - Up, to));
+		}
+
+		while (dbl) {
+			Square to = pop_lsb(dbl);
+			list.push(Move(to - 2 * Up, to));
+		}
+	}
+
+	if constexpr (Type != QUIETS) {
+		if (pawns_on_7) {
+			Bitboard push  = shift<Up>(pawns_on_7) & empty;
+			Bitboard right = shift<UpRight>(pawns_on_7) & enemies;
+			Bitboard left  = shift<UpLeft>(pawns_on_7) & enemies;
+
+			if constexpr (Type == EVASIONS) push &= target;
+
+			while (push) push_promotions<Up>(list, pop_lsb(push));
+			while (right) push_promotions<UpRight>(list, pop_lsb(right));
+			while (left) push_promotions<UpLeft>(list, pop_lsb(left));
+		}
+
+		Bitboard right = shift<UpRight>(pawns_not_7) & enemies;
+		Bitboard left  = shift<UpLeft>(pawns_not_7) & enemies;
+
+		while (right) {
+			Square to = pop_lsb(right);
+			list.push(Move(to - UpRight, to));
+		}
+
+		while (left) {
+			Square to = pop_lsb(left);
+			list.push(Move(to - UpLeft, to));
+		}
+
+		Square ep = board.en_passant_square();
+		if (ep != NO_SQUARE) {
+			// En passant only answers a check given by the pawn that just moved.
+			if (Type == EVASIONS && !(target & square_bb(ep - Up))) return;
+
+			Bitboard b = pawns_not_7 & pawn_attacks(Them, ep);
+			while (b) list.push(Move(pop_lsb(b), ep, Move::EN_PASSANT));
+		}
+	}
+}
+
+template <Color Us, PieceType Pt>
+void generate_piece_moves(const Board &board, MoveList<> &list, Bitboard target) {
+	Bitboard b = board.pieces(Us, Pt);
+
+	while (b) {
+		Square	 from	  = pop_lsb(b);
+		Bitboard attacked = attacks(Pt, from, board.pieces()) & target;
+
+		while (attacked) list.push(Move(from, pop_lsb(attacked)));
+	}
+}
+
+template <Color Us, GenType Type>
+void generate_all(const Board &board, MoveList<> &list) {
+	constexpr Color Them	 = ~Us;
+	const Square	ksq		 = board.king_square(Us);
+	const Bitboard	checkers = board.checkers(Us);
+	Bitboard		target	 = 0;
+
+	// With two checkers only the king can move.
+	if (Type != EVASIONS || !more_than_one(checkers)) {
+		if constexpr (Type == EVASIONS) target = between(ksq, lsb(checkers)) | checkers;
+		if constexpr (Type == NON_EVASIONS) target = ~board.pieces(Us);
+		if constexpr (Type == CAPTURES) target = board.pieces(Them);
+		if constexpr (Type == QUIETS) target = ~board.pieces();
+
+		generate_pawn_moves<Us, Type>(board, list, target);
+		generate_piece_moves<Us, KNIGHT>(board, list, target);
+		generate_piece_moves<Us, BISHOP>(board, list, target);
+		generate_piece_moves<Us, ROOK>(board, list, target);
+		generate_piece_moves<Us, QUEEN>(board, list, target);
+	}
+
+	Bitboard king_target = Type == EVASIONS ? ~board.pieces(Us) : target;
+	Bitboard b			 = king_attacks(ksq) & king_target & ~board.attacked_by(Them);
+
+	while (b) list.push(Move(ksq, pop_lsb(b)));
+
+	if constexpr (Type == QUIETS || Type == NON_EVASIONS) {
+		constexpr uint8_t OO  = Us == WHITE ? WHITE_OO : BLACK_OO;
+		constexpr uint8_t OOO = Us == WHITE ? WHITE_OOO : BLACK_OOO;
+
+		const uint8_t	  rights = board.castling_rights();
+		const uint8_t	  row	 = row_of(ksq);
+
+		if ((rights & OO) && !(between(ksq, make_square(7, row)) & board.pieces()))
+			list.push(Move(ksq, make_square(6, row), Move::CASTLING));
+		if ((rights & OOO) && !(between(ksq, make_square(0, row)) & board.pieces()))
+			list.push(Move(ksq, make_square(2, row), Move::CASTLING));
+	}
+}
+
+template <GenType Type>
+void dispatch(const Board &board, MoveList<> &list) {
+	board.side_to_move() == WHITE ? generate_all<WHITE, Type>(board, list)
+								  : generate_all<BLACK, Type>(board, list);
+}
+
+}  // namespace
+
+template <GenType Type>
+void generate(const Board &board, MoveList<> &list) {
+	if constexpr (Type == LEGAL) {
+		Color	 us		 = board.side_to_move();
+		Square	 ksq	 = board.king_square(us);
+		Bitboard pinned	 = board.pinned(us);
+		bool	 checked = board.in_check(us);
+
+		checked ? dispatch<EVASIONS>(board, list) : dispatch<NON_EVASIONS>(board, list);
+
+		// King steps were already checked against the attack map, which is exact unless a slider gives
+		// check through the king. What is left to verify is pins, castling paths and en passant.
+		size_t kept = 0;
+		for (size_t i = 0; i < list.size(); i++) {
+			Move m			= list[i].move;
+			bool suspicious = (pinned & square_bb(m.from())) || (checked && m.from() == ksq) ||
+							  m.flag() == Move::EN_PASSANT || m.flag() == Move::CASTLING;
+
+			if (suspicious && !board.legal(m)) continue;
+
+			list[kept++] = list[i];
+		}
+
+		list.resize(kept);
+	} else {
+		dispatch<Type>(board, list);
+	}
+}
+
+template void generate<CAPTURES>(const Board &board, MoveList<> &list);
+template void generate<QUIETS>(const Board &board, MoveList<> &list);
+template void generate<EVASIONS>(const Board &board, MoveList<> &list);
+template void generate<NON_EVASIONS>(const Board &board, MoveList<> &list);
+template void generate<LEGAL>(const Board &board, MoveList<> &list);
+
+uint64_t perft(Board &board, int depth) {
+	MoveList<> moves;
+	generate<LEGAL>(board, moves);
+
+	if (depth <= 1) return depth == 1 ? moves.size() : 1;
+
+	uint64_t nodes = 0;
+	for (const auto &[m, score] : moves) {
+		board.do_move(m);
+		nodes += perft(board, depth - 1);
+		board.undo_move(m);
+	}
+
+	return nodes;
+}
+
+}  // namespace app::game
@@ -8,9 +8,14 @@ using Coord = app::game::coord::Notation;
 
 namespace app::game {
 
-PieceKind::PieceKind(std::string name, bool is_white, std::string algebraic_name, MoveChecker checker)
+PieceKind::PieceKind(std::string name,
+	bool						  is_white,
+	PieceType					  type,
+	std::string					  algebraic_name,
+	MoveChecker					  checker)
 	: _name(std::move(name)),
 	  _is_white(is_white),
+	  _type(type),
 	  _algebraic_name(std::move(algebraic_name)),
 	  _checker(std::move(checker)) {
 }
@@ -27,6 +32,22 @@ bool PieceKind::is_white() const {
 	return _is_white;
 }
 
+Color PieceKind::get_color() const {
+	return _is_white ? WHITE : BLACK;
+}
+
+PieceType PieceKind::get_type() const {
+	return _type;
+}
+
+uint8_t PieceKind::get_id() const {
+	return get_color() * PIECE_TYPE_NB + _type;
+}
+
+const PieceKind& PieceKind::from_id(uint8_t id) {
+	return ALL_PIECE_KINDS.at(id);
+}
+
 std::filesystem::path PieceKind::get_sprite_path() const {
 	using std::filesystem::path;
 
@@ -97,19 +118,19 @@ bool king_static_checker(const Coord& origin, const Coord& target) {
 	return std::abs(dx) <= 1 && std::abs(dy) <= 1;
 }
 
-const PieceKind				 PieceKind::BLACK_PAWN	 = PieceKind("pawn", false, "", PawnStaticChecker(false));
-const PieceKind				 PieceKind::BLACK_KNIGHT = PieceKind("knight", false, "n", knight_static_checker);
-const PieceKind				 PieceKind::BLACK_BISHOP = PieceKind("bishop", false, "b", bishop_static_checker);
-const PieceKind				 PieceKind::BLACK_ROOK	 = PieceKind("rook", false, "r", rook_static_checker);
-const PieceKind				 PieceKind::BLACK_QUEEN	 = PieceKind("queen", false, "q", queen_static_checker);
-const PieceKind				 PieceKind::BLACK_KING	 = PieceKind("king", false, "k", king_static_checker);
-
-const PieceKind				 PieceKind::WHITE_PAWN	 = PieceKind("pawn", true, "", PawnStaticChecker(true));
-const PieceKind				 PieceKind::WHITE_KNIGHT = PieceKind("knight", true, "n", knight_static_checker);
-const PieceKind				 PieceKind::WHITE_BISHOP = PieceKind("bishop", true, "b", bishop_static_checker);
-const PieceKind				 PieceKind::WHITE_ROOK	 = PieceKind("rook", true, "r", rook_static_checker);
-const PieceKind				 PieceKind::WHITE_QUEEN	 = PieceKind("queen", true, "q", queen_static_checker);
-const PieceKind				 PieceKind::WHITE_KING	 = PieceKind("king", true, "k", king_static_checker);
+const PieceKind				 PieceKind::BLACK_PAWN	 = PieceKind("pawn", false, PAWN, "", PawnStaticChecker(false));
+const PieceKind				 PieceKind::BLACK_KNIGHT = PieceKind("knight", false, KNIGHT, "n", knight_static_checker);
+const PieceKind				 PieceKind::BLACK_BISHOP = PieceKind("bishop", false, BISHOP, "b", bishop_static_checker);
+const PieceKind				 PieceKind::BLACK_ROOK	 = PieceKind("rook", false, ROOK, "r", rook_static_checker);
+const PieceKind				 PieceKind::BLACK_QUEEN	 = PieceKind("queen", false, QUEEN, "q", queen_static_checker);
+const PieceKind				 PieceKind::BLACK_KING	 = PieceKind("king", false, KING, "k", king_static_checker);
+
+const PieceKind				 PieceKind::WHITE_PAWN	 = PieceKind("pawn", true, PAWN, "", PawnStaticChecker(true));
+const PieceKind				 PieceKind::WHITE_KNIGHT = PieceKind("knight", true, KNIGHT, "n", knight_static_checker);
+const PieceKind				 PieceKind::WHITE_BISHOP = PieceKind("bishop", true, BISHOP, "b", bishop_static_checker);
+const PieceKind				 PieceKind::WHITE_ROOK	 = PieceKind("rook", true, ROOK, "r", rook_static_checker);
+const PieceKind				 PieceKind::WHITE_QUEEN	 = PieceKind("queen", true, QUEEN, "q", queen_static_checker);
+const PieceKind				 PieceKind::WHITE_KING	 = PieceKind("king", true, KING, "k", king_static_checker);
 
 const std::vector<PieceKind> PieceKind::ALL_PIECE_KINDS{
 	BLACK_PAWN,
@@ -0,0 +1,138 @@
+#include "game/see.hpp"
+
+#include <algorithm>
+#include <optional>
+
+namespace app::game {
+
+using bitboard::Bitboard;
+using bitboard::Square;
+
+namespace {
+
+PieceType type_on(const Board &board, Square s) {
+	return static_cast<PieceType>(board.piece_on(s) % PIECE_TYPE_NB);
+}
+
+// Picks the least valuable attacker of `side` out of `attackers`, removes it from `occupied` and adds any
+// slider that was hidden behind it. Returns the attacker type, or nothing when `side` has no attacker left.
+std::optional<PieceType> pop_least_valuable(const Board &board,
+	Square												to,
+	Color												side,
+	Bitboard										   &attackers,
+	Bitboard										   &occupied) {
+	Bitboard side_attackers = attackers & board.pieces(side);
+	if (!side_attackers) return std::nullopt;
+
+	for (uint8_t i = PAWN; i <= KING; i++) {
+		auto	 pt = static_cast<PieceType>(i);
+		Bitboard b	= side_attackers & board.pieces(pt);
+
+		if (!b) continue;
+
+		occupied ^= b & -b;
+
+		if (pt == PAWN || pt == BISHOP || pt == QUEEN)
+			attackers |= bitboard::bishop_attacks(to, occupied) & (board.pieces(BISHOP) | board.pieces(QUEEN));
+		if (pt == ROOK || pt == QUEEN)
+			attackers |= bitboard::rook_attacks(to, occupied) & (board.pieces(ROOK) | board.pieces(QUEEN));
+
+		attackers &= occupied;
+		return pt;
+	}
+
+	return std::nullopt;
+}
+
+}  // namespace
+
+int see(const Board &board, Square from, Square to) {
+	std::array<int, 32> gain{};
+	size_t				depth	  = 0;
+
+	Bitboard			occupied  = board.pieces() ^ bitboard::square_bb(from);
+	Bitboard			attackers = board.attackers_to(to, occupied) & occupied;
+	Color				side	  = board.pieces(WHITE) & bitboard::square_bb(from) ? BLACK : WHITE;
+	PieceType			on_square = type_on(board, from);
+
+	gain[0]						  = board.piece_on(to) != NO_PIECE ? SEE_VALUES[type_on(board, to)] : 0;
+
+	while (auto pt = pop_least_valuable(board, to, side, attackers, occupied)) {
+		depth++;
+		gain[depth] = SEE_VALUES[on_square] - gain[depth - 1];
+
+		// Capturing with the king into a defended square is illegal, so the exchange stops before it.
+		if (*pt == KING && (attackers & board.pieces(~side))) {
+			depth--;
+			break;
+		}
+
+		// Neither standing pat nor capturing helps the side to move: the rest of the sequence cannot change
+		// the outcome.
+		if (std::max(-gain[depth - 1], gain[depth]) < 0) {
+			depth--;
+			break;
+		}
+
+		on_square = *pt;
+		side	  = ~side;
+	}
+
+	while (depth) {
+		gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+		depth--;
+	}
+
+	return gain[0];
+}
+
+bool see_ge(const Board &board, Square from, Square to, int threshold) {
+	int swap = (board.piece_on(to) != NO_PIECE ? SEE_VALUES[type_on(board, to)] : 0) - threshold;
+	if (swap < 0) return false;
+
+	swap = SEE_VALUES[type_on(board, from)] - swap;
+	if (swap <= 0) return true;
+
+	Bitboard occupied  = board.pieces() ^ bitboard::square_bb(from) ^ bitboard::square_bb(to);
+	Bitboard attackers = board.attackers_to(to, occupied) & occupied;
+	Color	 side	   = board.pieces(WHITE) & bitboard::square_bb(from) ? WHITE : BLACK;
+	bool	 result	   = true;
+
+	while (true) {
+		side = ~side;
+
+		auto pt = pop_least_valuable(board, to, side, attackers, occupied);
+		if (!pt) break;
+
+		result = !result;
+
+		// A king may only recapture when the other side has nothing left to take it with.
+		if (*pt == KING) return (attackers & board.pieces(~side)) ? !result : result;
+
+		swap = SEE_VALUES[*pt] - swap;
+		if (swap < static_cast<int>(result)) break;
+	}
+
+	return result;
+}
+
+Bitboard hanging_pieces(const Board &board, Color c) {
+	Bitboard hanging = 0;
+	Bitboard targets = board.pieces(c) & ~board.pieces(KING);
+
+	while (targets) {
+		Square	 s		   = bitboard::pop_lsb(targets);
+		Bitboard attackers = board.attackers_to(s, board.pieces()) & board.pieces(~c);
+
+		while (attackers) {
+			if (see(board, bitboard::pop_lsb(attackers), s) > 0) {
+				hanging |= bitboard::square_bb(s);
+				break;
+			}
+		}
+	}
+
+	return hanging;
+}
+
+}  // namespace app::game
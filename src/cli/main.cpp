@@ -0,0 +1,27 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "cli/shell.hpp"
+#include "game/bitbase.hpp"
+#include "game/bitboard.hpp"
+
+int main(int argc, char **argv) {
+	app::game::bitboard::init();
+	app::game::bitbase::init();
+
+	cli::Shell shell(std::cin, std::cout);
+
+	// Arguments run as one command and exit, e.g. `chess-engine bench 13`.
+	if (argc > 1) {
+		std::string command;
+		for (int i = 1; i < argc; i++) command += std::string(i > 1 ? " " : "") + argv[i];
+
+		shell.execute(command);
+		return EXIT_SUCCESS;
+	}
+
+	shell.run();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,374 @@
+#include "cli/shell.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+
+#include "game/evaluate.hpp"
+#include "game/fill.hpp"
+#include "game/movegen.hpp"
+
+namespace cli {
+
+namespace {
+
+constexpr size_t DEFAULT_HASH_MB	 = 16;
+constexpr int	 DEFAULT_BENCH_DEPTH = 11;
+
+// Middlegames, endgames and tactical positions; changing the list changes the bench signature.
+constexpr const char *BENCH_FENS[] = {
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 10",
+	"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 11",
+	"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+	"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+	"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+	"r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+	"2r3k1/pp3ppp/2n1b3/3p4/3P4/2PB1N2/P4PPP/R5K1 b - - 0 20",
+	"r1b2rk1/2q1b1pp/p2ppn2/1p6/3QP3/1BN1B3/PPP3PP/R4RK1 w - - 0 12",
+	"4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+	"6k1/6p1/6Pp/ppp5/3pn2P/1P3K2/1PP2P2/3N4 b - - 0 1",
+	"8/8/1p1k4/p1p3p1/P1P1K1P1/1P6/8/8 w - - 0 1",
+	"8/3k4/8/8/8/4B3/4KB2/2B5 w - - 0 1",
+	"5k2/7R/4P2p/5K2/p1r2P1p/8/8/8 b - - 0 1",
+};
+
+std::string format_score(int score) {
+	using namespace app::engine;
+
+	if (std::abs(score) < VALUE_MATE_IN_MAX_PLY) return "cp " + std::to_string(score);
+
+	int plies = VALUE_MATE - std::abs(score);
+	return "mate " + std::to_string(score > 0 ? (plies + 1) / 2 : -(plies + 1) / 2);
+}
+
+}  // namespace
+
+Shell::Shell(std::istream &input, std::ostream &output)
+	: in(input),
+	  out(output),
+	  board(false),
+	  search(tt, &cache),
+	  threads(1),
+	  infinite(false),
+	  stop_requested(false) {
+	tt.resize(DEFAULT_HASH_MB, threads);
+
+	commands.emplace("uci", [this](std::istringstream &args) { uci(args); });
+	commands.emplace("isready", [this](std::istringstream &) {
+		std::lock_guard lock(out_mutex);
+		out << "readyok" << std::endl;
+	});
+	commands.emplace("ucinewgame", [this](std::istringstream &) {
+		tt.clear(threads);
+		cache.import(tt);
+	});
+	commands.emplace("setoption", [this](std::istringstream &args) { setoption(args); });
+	commands.emplace("position", [this](std::istringstream &args) { position(args); });
+	commands.emplace("go", [this](std::istringstream &args) { go(args); });
+	commands.emplace("stop", [this](std::istringstream &args) { stop(args); });
+	commands.emplace("perft", [this](std::istringstream &args) { perft(args); });
+	commands.emplace("d", [this](std::istringstream &args) { display(args); });
+	commands.emplace("eval", [this](std::istringstream &args) { evaluate(args); });
+	commands.emplace("sliders", [this](std::istringstream &args) { sliders(args); });
+	commands.emplace("bench", [this](std::istringstream &args) { bench(args); });
+}
+
+Shell::~Shell() {
+	wait_for_search();
+}
+
+void Shell::run() {
+	std::string line;
+
+	while (std::getline(in, line)) {
+		if (!execute(line)) break;
+	}
+
+	wait_for_search();
+
+	if (!analysis_file.empty() && !cache.save(analysis_file))
+		out << "info string cannot write " << analysis_file.string() << std::endl;
+}
+
+bool Shell::execute(const std::string &line) {
+	std::istringstream args(line);
+	std::string		   name;
+
+	if (!(args >> name)) return true;
+	if (name == "quit") {
+		stop(args);
+		wait_for_search();
+		return false;
+	}
+
+	auto it = commands.find(name);
+	if (it == commands.end()) {
+		std::lock_guard lock(out_mutex);
+		out << "unknown command: " << name << std::endl;
+		return true;
+	}
+
+	if (name != "stop" && name != "isready") wait_for_search();
+
+	try {
+		it->second(args);
+	} catch (const app::game::InvalidFenException &e) {
+		out << e.what() << std::endl;
+	}
+
+	return true;
+}
+
+void Shell::uci(std::istringstream &) {
+	out << "id name chess\n";
+	out << "id author PatateDu609\n";
+	out << "option name Hash type spin default " << DEFAULT_HASH_MB << " min 1 max 262144\n";
+	out << "option name Threads type spin default 1 min 1 max 256\n";
+	out << "option name Analysis File type string default <empty>\n";
+	out << "uciok" << std::endl;
+}
+
+// setoption name <id> value <x>
+void Shell::setoption(std::istringstream &args) {
+	std::string token, name, value;
+
+	args >> token;
+	while (args >> token && token != "value") name += (name.empty() ? "" : " ") + token;
+	std::getline(args >> std::ws, value);
+
+	try {
+		if (name == "Hash") {
+			tt.resize(std::stoul(value), threads);
+			cache.import(tt);
+			out << "info string hash " << tt.size_mb() << " MB on " << tt.page_info() << std::endl;
+		} else if (name == "Analysis File") {
+			analysis_file = value == "<empty>" ? "" : value;
+			if (analysis_file.empty()) return;
+
+			size_t loaded = cache.load(analysis_file, tt);
+			out << "info string " << loaded << " cached positions loaded from " << value << std::endl;
+		} else if (name == "Threads") {
+			threads = std::max<size_t>(1, std::stoul(value));
+		} else {
+			out << "info string unknown option " << name << std::endl;
+		}
+	} catch (const std::logic_error &) {
+		out << "info string bad value for " << name << std::endl;
+	}
+}
+
+// position [startpos | fen <fen>] [moves <m1> <m2> ...]
+void Shell::position(std::istringstream &args) {
+	std::string token, fen;
+
+	args >> token;
+	if (token == "startpos") {
+		fen = app::game::Board::START_FEN;
+		args >> token;
+	} else if (token == "fen") {
+		while (args >> token && token != "moves") fen += token + ' ';
+	} else {
+		out << "expected startpos or fen" << std::endl;
+		return;
+	}
+
+	board.set_fen(fen);
+
+	while (args >> token) {
+		app::game::MoveList<> legal;
+		app::game::generate<app::game::LEGAL>(board, legal);
+
+		auto it = std::find_if(legal.begin(), legal.end(), [&token](const app::game::ScoredMove &sm) {
+			return sm.move.to_string() == token;
+		});
+
+		if (it == legal.end()) {
+			out << "illegal move: " << token << std::endl;
+			return;
+		}
+
+		board.do_move(it->move);
+	}
+}
+
+// go [depth d] [nodes n] [movetime ms] [wtime ms] [btime ms] [winc ms] [binc ms] [movestogo n] [infinite]
+// Returns at once; the search reports `bestmove` when it is done. An infinite search only ends on `stop`.
+void Shell::go(std::istringstream &args) {
+	using app::game::BLACK;
+	using app::game::WHITE;
+
+	app::engine::Limits limits;
+	std::string			token;
+
+	infinite = false;
+	while (args >> token) {
+		if (token == "depth") args >> limits.depth;
+		else if (token == "nodes") args >> limits.nodes;
+		else if (token == "movetime") args >> limits.movetime;
+		else if (token == "wtime") args >> limits.time[WHITE];
+		else if (token == "btime") args >> limits.time[BLACK];
+		else if (token == "winc") args >> limits.inc[WHITE];
+		else if (token == "binc") args >> limits.inc[BLACK];
+		else if (token == "movestogo") args >> limits.movestogo;
+		else if (token == "infinite") infinite = true;
+	}
+
+	// Iterative deepening always completes depth 1, so there is a move to report.
+	limits.depth = std::max(limits.depth, 1);
+
+	search.clear_stop();
+	stop_requested = false;
+	searcher	   = std::thread(&Shell::think, this, limits, infinite);
+}
+
+// Search thread.
+void Shell::think(app::engine::Limits limits, bool infinite_search) {
+	auto result = search.run(board, limits, [this](const app::engine::Info &info) {
+		uint64_t		nps = info.nodes * 1000 / std::max<int64_t>(info.time_ms, 1);
+		std::lock_guard lock(out_mutex);
+
+		out << "info depth " << info.depth << " score " << format_score(info.score) << " nodes " << info.nodes
+			<< " nps " << nps << " hashfull " << info.hashfull << " time " << info.time_ms << " pv";
+		for (auto m : info.pv) out << ' ' << m.to_string();
+		out << std::endl;
+	});
+
+	// UCI wants the best move of an infinite search only after `stop`, even if the search ran out of depth.
+	if (infinite_search) stop_requested.wait(false);
+
+	std::lock_guard lock(out_mutex);
+	out << "bestmove " << (result.pv.empty() ? app::game::Move::none() : result.pv[0]).to_string() << std::endl;
+}
+
+void Shell::stop(std::istringstream &) {
+	search.stop();
+	stop_requested = true;
+	stop_requested.notify_one();
+}
+
+// Called before anything touching the board or the table. An infinite search would never end on its own, so
+// it is stopped.
+void Shell::wait_for_search() {
+	if (!searcher.joinable()) return;
+
+	if (infinite) {
+		std::istringstream none;
+		stop(none);
+	}
+	searcher.join();
+}
+
+// perft <depth>: node count per root move, then the total and the speed.
+void Shell::perft(std::istringstream &args) {
+	int depth = 1;
+	args >> depth;
+	if (depth < 1) depth = 1;
+
+	app::game::MoveList<> moves;
+	app::game::generate<app::game::LEGAL>(board, moves);
+
+	auto	 start = std::chrono::steady_clock::now();
+	uint64_t total = 0;
+
+	for (const auto &[m, score] : moves) {
+		board.do_move(m);
+		uint64_t nodes = app::game::perft(board, depth - 1);
+		board.undo_move(m);
+
+		total += nodes;
+		out << m.to_string() << ": " << nodes << '\n';
+	}
+
+	auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	out << "\nnodes " << total << " (" << app::game::bitboard::slider_backend_name() << " sliders)\n";
+	out << "time  " << static_cast<uint64_t>(elapsed * 1000) << " ms\n";
+	out << "nps   " << static_cast<uint64_t>(static_cast<double>(total) / std::max(elapsed, 1e-9)) << std::endl;
+}
+
+void Shell::display(std::istringstream &) {
+	constexpr const char *PIECE_CHARS = "pnbrqkPNBRQK.";
+
+	for (uint8_t y = 0; y < 8; y++) {
+		out << 8 - y << "  ";
+		for (uint8_t x = 0; x < 8; x++) {
+			uint8_t piece = board.piece_on(app::game::bitboard::make_square(x, y));
+			out << PIECE_CHARS[piece] << ' ';
+		}
+		out << '\n';
+	}
+
+	out << "\n   a b c d e f g h\n\nfen: " << board.fen() << '\n';
+	out << "key: " << std::hex << board.key() << std::dec << std::endl;
+}
+
+void Shell::evaluate(std::istringstream &) {
+	auto trace = app::game::eval::trace(board);
+
+	out << "features (white - black):";
+	for (int f : trace.features) out << ' ' << f;
+	out << "\nphase " << trace.phase << '/' << app::game::eval::PHASE_MAX;
+	out << " (" << app::game::bitboard::fill_backend_name() << " fills)\n";
+	out << "eval  " << app::game::evaluate(board) << " cp, side to move" << std::endl;
+}
+
+// sliders [auto | magic | pext]: shows or switches the slider attack backend.
+void Shell::sliders(std::istringstream &args) {
+	using app::game::bitboard::SliderBackend;
+
+	std::string name;
+	if (args >> name) {
+		if (name == "auto") {
+			app::game::bitboard::init(SliderBackend::AUTO);
+		} else if (name == "magic") {
+			app::game::bitboard::init(SliderBackend::MAGIC);
+		} else if (name == "pext") {
+			app::game::bitboard::init(SliderBackend::PEXT);
+		} else {
+			out << "expected auto, magic or pext" << std::endl;
+			return;
+		}
+	}
+
+	out << "sliders: " << app::game::bitboard::slider_backend_name() << std::endl;
+}
+
+// bench [depth]: searches the bench positions from an empty table. The node total is a signature of the search
+// (any change to it changes search behaviour); nodes per second track raw speed.
+void Shell::bench(std::istringstream &args) {
+	app::engine::Limits limits;
+	limits.depth = DEFAULT_BENCH_DEPTH;
+	args >> limits.depth;
+
+	// A search of its own, so that bench positions stay out of the analysis cache.
+	auto	 bench_search = std::make_unique<app::engine::Search>(tt);
+	uint64_t nodes		  = 0;
+	auto	 start		  = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < std::size(BENCH_FENS); i++) {
+		board.set_fen(BENCH_FENS[i]);
+		tt.clear(threads);
+
+		auto result	 = bench_search->run(board, limits);
+		nodes		+= result.nodes;
+
+		out << "position " << i + 1 << '/' << std::size(BENCH_FENS) << ": " << result.nodes << " nodes, bestmove "
+			<< (result.pv.empty() ? app::game::Move::none() : result.pv[0]).to_string() << '\n';
+	}
+
+	auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+	tt.clear(threads);
+	cache.import(tt);
+	board.set_fen(app::game::Board::START_FEN);
+
+	out << "\nTotal time (ms) : " << ms.count() << "\nNodes searched  : " << nodes
+		<< "\nNodes/second    : " << nodes * 1000 / std::max<uint64_t>(ms.count(), 1) << std::endl;
+}
+
+}  // namespace cli
@@ -0,0 +1,80 @@
+#include "graphics/atlas.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "graphics/window.hpp"
+
+namespace graphics {
+
+SpriteAtlas::SpriteAtlas(const std::shared_ptr<SDL_Renderer> &renderer, const std::vector<SDL_Surface *> &surfaces) {
+	int cell_w = 1, cell_h = 1;
+	for (const auto *surface : surfaces) {
+		cell_w = std::max(cell_w, surface->w);
+		cell_h = std::max(cell_h, surface->h);
+	}
+
+	auto columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(surfaces.size()))));
+	auto rows	 = (static_cast<int>(surfaces.size()) + columns - 1) / std::max(columns, 1);
+	int	 width	 = std::max(columns, 1) * cell_w;
+	int	 height	 = std::max(rows, 1) * cell_h;
+
+	std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> sheet(
+		SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32), SDL_FreeSurface);
+	if (!sheet) throw SDLException("couldn't create atlas surface");
+
+	for (size_t i = 0; i < surfaces.size(); i++) {
+		SDL_Rect dst{static_cast<int>(i) % columns * cell_w, static_cast<int>(i) / columns * cell_h, surfaces[i]->w,
+					 surfaces[i]->h};
+
+		// Copy the sprite's alpha as is instead of blending it onto the empty sheet.
+		SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+		SDL_BlitSurface(surfaces[i], nullptr, sheet.get(), &dst);
+		SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_BLEND);
+
+		cells.push_back({static_cast<float>(dst.x) / static_cast<float>(width),
+						 static_cast<float>(dst.y) / static_cast<float>(height),
+						 static_cast<float>(dst.w) / static_cast<float>(width),
+						 static_cast<float>(dst.h) / static_cast<float>(height)});
+	}
+
+	texture.reset(SDL_CreateTextureFromSurface(renderer.get(), sheet.get()), SDL_DestroyTexture);
+	if (!texture) throw SDLException("couldn't create atlas texture");
+
+	SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+}
+
+void SpriteAtlas::draw(const std::shared_ptr<SDL_Renderer> &renderer, std::span<const Sprite> sprites) const {
+	if (sprites.empty()) return;
+
+	std::vector<SDL_Vertex> vertices;
+	std::vector<int>		indices;
+	vertices.reserve(4 * sprites.size());
+	indices.reserve(6 * sprites.size());
+
+	for (const auto &[index, dst, color] : sprites) {
+		const SDL_FRect &src  = cells.at(index);
+		auto			 base = static_cast<int>(vertices.size());
+
+		auto			 x0	  = static_cast<float>(dst.x);
+		auto			 y0	  = static_cast<float>(dst.y);
+		auto			 x1	  = static_cast<float>(dst.x + dst.w);
+		auto			 y1	  = static_cast<float>(dst.y + dst.h);
+
+		vertices.push_back({{x0, y0}, color, {src.x, src.y}});
+		vertices.push_back({{x1, y0}, color, {src.x + src.w, src.y}});
+		vertices.push_back({{x1, y1}, color, {src.x + src.w, src.y + src.h}});
+		vertices.push_back({{x0, y1}, color, {src.x, src.y + src.h}});
+
+		for (int corner : {0, 1, 2, 0, 2, 3}) indices.push_back(base + corner);
+	}
+
+	SDL_RenderGeometry(renderer.get(), texture.get(), vertices.data(), static_cast<int>(vertices.size()),
+					   indices.data(), static_cast<int>(indices.size()));
+}
+
+size_t SpriteAtlas::size() const {
+	return cells.size();
+}
+
+}  // namespace graphics
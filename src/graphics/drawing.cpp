@@ -0,0 +1,174 @@
+#include "graphics/drawing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+#include "game/piece.hpp"
+
+namespace graphics::game {
+
+Position::Position()
+	: flipped(false) {
+	pieces.fill(app::game::NO_PIECE);
+}
+
+Position::Position(const app::game::Board &board)
+	: flipped(board.flipped()) {
+	for (app::game::bitboard::Square s = 0; s < app::game::bitboard::SQUARE_NB; s++) pieces[s] = board.piece_on(s);
+}
+
+// The sprites are rasterized on a few threads: at startup this is the bulk of the work.
+PieceSprites load_piece_sprites(size_t size) {
+	using ImageManager = app::resources::ResourceManager<app::resources::Image>;
+	using Clock		   = std::chrono::steady_clock;
+
+	const auto	start	= Clock::now();
+	const auto &manager = ImageManager::get();
+	const auto &kinds	= app::game::PieceKind::ALL_PIECE_KINDS;
+
+	PieceSprites images(kinds.size());
+
+	std::atomic<size_t>		 next(0);
+	std::exception_ptr		 error;
+	std::mutex				 error_lock;
+	std::vector<std::thread> workers;
+
+	size_t threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, kinds.size());
+	for (size_t t = 0; t < threads; t++) {
+		workers.emplace_back([&] {
+			for (size_t i; (i = next++) < kinds.size();) {
+				try {
+					images[i] = manager->make(kinds[i].get_sprite_path(), size, size);
+				} catch (...) {
+					std::scoped_lock guard(error_lock);
+					if (!error) error = std::current_exception();
+				}
+			}
+		});
+	}
+	for (auto &w : workers) w.join();
+
+	if (error) std::rethrow_exception(error);
+
+	auto elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	std::clog << size << "px piece sprites loaded in " << elapsed << " ms on " << threads << " threads" << std::endl;
+
+	return images;
+}
+
+SpriteAtlas make_piece_atlas(const std::shared_ptr<SDL_Renderer> &renderer, const PieceSprites &sprites) {
+	// The images own their surfaces, the raw pointers stay valid while the atlas is built.
+	std::vector<SDL_Surface *> surfaces;
+	for (const auto &image : sprites) {
+		auto surface = image->get().lock();
+		if (!surface) throw std::runtime_error("couldn't lock image");
+
+		surfaces.push_back(surface.get());
+	}
+
+	return {renderer, surfaces};
+}
+
+size_t piece_size(int case_size) {
+	return static_cast<size_t>(case_size * 0.8);
+}
+
+// 18 points on the original 100 pixel squares.
+size_t label_font_size(int case_size) {
+	return static_cast<size_t>(std::max(8, 18 * case_size / 100));
+}
+
+window::Coord sprite_coord(int case_size, size_t x, size_t y) {
+	const double shift = case_size * 0.1;
+	return {
+		.x = static_cast<size_t>((static_cast<double>(x) * case_size) + shift),
+		.y = static_cast<size_t>((static_cast<double>(y) * case_size) + shift),
+	};
+}
+
+void draw_squares(const std::shared_ptr<SDL_Renderer> &renderer, int case_size) {
+	Color col;
+
+	for (size_t y = 0; y < 8; y++) {
+		bool y_even = y % 2 == 0;
+
+		for (size_t x = 0; x < 8; x++) {
+			bool x_even = x % 2 == 0;
+
+			if (y_even) {
+				col = x_even ? Color::LIGHT_SQUARE : Color::DARK_SQUARE;
+			} else {
+				col = x_even ? Color::DARK_SQUARE : Color::LIGHT_SQUARE;
+			}
+
+			SDL_Rect rect;
+			rect.w = rect.h = case_size;
+			rect.x			= static_cast<int>(x) * case_size;
+			rect.y			= static_cast<int>(y) * case_size;
+
+			SDL_SetRenderDrawColor(renderer.get(), col.r(), col.g(), col.b(), col.a());
+			SDL_RenderFillRect(renderer.get(), &rect);
+		}
+	}
+}
+
+void draw_labels(const std::shared_ptr<SDL_Renderer> &renderer, const GlyphAtlas &glyphs, int case_size,
+	bool flipped) {
+	// Views into these literals, one character each.
+	constexpr std::string_view	  NUMBERS = "87654321";
+	constexpr std::string_view	  LETTERS = "abcdefgh";
+
+	std::vector<GlyphAtlas::Text> labels;
+	labels.reserve(16);
+
+	for (size_t i = 0; i < 8; i++) {
+		size_t rank = flipped ? 7 - i : i;
+
+		labels.push_back({
+			.content = NUMBERS.substr(rank, 1),
+			.x		 = static_cast<int>(.06 * case_size),
+			.y		 = static_cast<int>((static_cast<double>(i) + 0.04) * case_size),
+			.color	 = i % 2 ? Color::LIGHT_SQUARE : Color::DARK_SQUARE,
+		});
+		labels.push_back({
+			.content = LETTERS.substr(rank, 1),
+			.x		 = static_cast<int>((static_cast<double>(i) + 0.8) * case_size),
+			.y		 = static_cast<int>(7.72 * case_size),
+			.color	 = i % 2 ? Color::DARK_SQUARE : Color::LIGHT_SQUARE,
+		});
+	}
+
+	glyphs.draw(renderer, labels);
+}
+
+void add_piece_sprites(const Position &position, int case_size, std::vector<SpriteAtlas::Sprite> &sprites,
+	app::game::bitboard::Square skip) {
+	using app::game::bitboard::make_square;
+
+	auto size = static_cast<int>(piece_size(case_size));
+
+	for (uint8_t y = 0; y < 8; y++) {
+		for (uint8_t x = 0; x < 8; x++) {
+			app::game::bitboard::Square s	  = make_square(x, y);
+			uint8_t						piece = position.pieces[s];
+			if (s == skip || piece == app::game::NO_PIECE) {
+				continue;
+			}
+
+			window::Coord coord =
+				position.flipped ? sprite_coord(case_size, 7 - x, 7 - y) : sprite_coord(case_size, x, y);
+
+			sprites.push_back({
+				.index = piece,
+				.dst   = {static_cast<int>(coord.x), static_cast<int>(coord.y), size, size},
+			});
+		}
+	}
+}
+
+}  // namespace graphics::game
@@ -1,207 +1,144 @@
 #include "graphics/game.hpp"
 
-#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <span>
+
+#include "game/see.hpp"
 
 namespace graphics::game {
 
 Board::Board(graphics::window::Window &window, bool empty)
 	: win(window),
 	  case_size(static_cast<int>(std::min(win.size().first / 8, win.size().second / 8))),
-	  board(empty) {
-	init_piece_renderers();
-}
-
-void Board::init_piece_renderers() {
-	piece_renderers.clear();
-	piece_renderers.reserve(PieceKind::ALL_PIECE_KINDS.size());
-
-	using graphics::ImageRenderer;
-
-	const size_t size = get_piece_size();
-	for (const auto &kind : PieceKind::ALL_PIECE_KINDS) {
-		ImageRenderer renderer(kind.get_sprite_path(), size, size);
-
-		piece_renderers.emplace(kind, std::move(renderer));
-	}
+	  layout_size(win.size()),
+	  board(empty),
+	  sprite_size(get_piece_size()),
+	  show_hints(true),
+	  hanging(0),
+	  background_epoch(0) {
+	piece_images = std::make_shared<const PieceSprites>(load_piece_sprites(sprite_size));
+	refresh_hints();
 }
 
 size_t Board::get_piece_size() const {
-	return static_cast<size_t>(case_size * 0.8);
+	return piece_size(case_size);
 }
 
 void Board::update() {
-	auto weak_renderer = win.get_renderer();
-
-	if (auto renderer = weak_renderer.lock()) {
-		check_pre_rendered(renderer);
-	}
-}
-
-void Board::draw() const {
-	draw_chessboard();
-	draw_pieces();
-	draw_selected();
+	check_layout();
+	check_piece_images();
 }
 
-void Board::draw_chessboard() const {
-	using graphics::Color;
-
-	auto  weak_renderer = win.get_renderer();
-	Color col;
-
-	if (auto renderer = weak_renderer.lock()) {
-		for (size_t y = 0; y < 8; y++) {
-			bool y_even = y % 2 == 0;
-
-			for (size_t x = 0; x < 8; x++) {
-				bool x_even = x % 2 == 0;
-
-				if (y_even) {
-					col = x_even ? Color::LIGHT_SQUARE : Color::DARK_SQUARE;
-				} else {
-					col = x_even ? Color::DARK_SQUARE : Color::LIGHT_SQUARE;
-				}
-
-				SDL_Rect rect;
-				rect.w = rect.h = case_size;
-				rect.x			= static_cast<int>(x) * case_size;
-				rect.y			= static_cast<int>(y) * case_size;
+Frame Board::snapshot() const {
+	using namespace app::game::bitboard;
+	using app::game::BLACK;
+	using app::game::KING;
+	using app::game::WHITE;
+	using std::max;
 
-				SDL_SetRenderDrawColor(renderer.get(), col.r(), col.g(), col.b(), col.a());
-				SDL_RenderFillRect(renderer.get(), &rect);
-			}
-		}
+	Frame frame;
+	if (board.is_valid()) frame.position = Position(board);
+	frame.case_size		   = case_size;
+	frame.sprites		   = piece_images;
+	frame.background_epoch = background_epoch;
+	frame.hanging		   = show_hints ? hanging : 0;
+	frame.outcome		   = outcome;
 
-		for (size_t i = 0; i < 8; i++) {
-			preRenderedBoardText.second.numbers[i].render();
-			preRenderedBoardText.second.letters[i].render();
-		}
-	} else {
-		throw std::runtime_error("couldn't get renderer: weak ptr expired");
+	for (auto c : {WHITE, BLACK}) {
+		if (board.in_check(c)) frame.checked |= board.pieces(c, KING);
 	}
-}
 
-void Board::draw_pieces() const {
-	if (!board.is_valid()) {
-		std::cerr << "board not valid, can't draw pieces" << std::endl;
-		return;
+	if (selected) {
+		auto win_size = win.size();
+		int	 x		  = max(0, selected->rect.x);
+		int	 y		  = max(0, selected->rect.y);
+
+		if (selected->rect.x + selected->rect.w > static_cast<int>(win_size.first))
+			x = static_cast<int>(win_size.first) - selected->rect.w;
+		if (selected->rect.y + selected->rect.h > static_cast<int>(win_size.second))
+			y = static_cast<int>(win_size.second) - selected->rect.h;
+
+		frame.dragged = SpriteAtlas::Sprite{
+			.index = selected->kind.get_id(),
+			.dst   = {x, y, selected->rect.w, selected->rect.h},
+		};
+		frame.position.pieces[make_square(selected->coord.x, selected->coord.y)] = app::game::NO_PIECE;
 	}
 
-	auto weak_renderer = win.get_renderer();
-
-	if (auto renderer = weak_renderer.lock()) {
-		size_t sx, sy;
-		if (has_selected()) {
-			sx = selected->coord.x;
-			sy = selected->coord.y;
-		}
-
-		for (size_t y = 0; y < 8; y++) {
-			for (size_t x = 0; x < 8; x++) {
-				if (selected.has_value() && x == sx && y == sy) {
-					continue;
-				}
-
-				auto kind = board.at(x, y);
-				if (!kind.has_value()) {
-					continue;
-				}
-
-				auto		  piece_renderer = piece_renderers.at(*kind);
-
-				window::Coord tex_coord{};
-
-				if (board.flipped()) {
-					tex_coord = gen_sprite_coord(7 - x, 7 - y);
-				} else {
-					tex_coord = gen_sprite_coord(x, y);
-				}
-
-				piece_renderer.set_coord(tex_coord.x, tex_coord.y);
-				piece_renderer.render(renderer);
-			}
-		}
-	}
+	return frame;
 }
 
-void Board::draw_selected() const {
-	using std::max;
-
-	if (!selected) return;
-
-	auto   win_size = win.size();
-
-	size_t x, y;
-	if (auto renderer = win.get_renderer().lock()) {
-		graphics::ImageRenderer img_renderer = piece_renderers.at(selected->kind);
-
-		x									 = max(0, selected->rect.x);
-		y									 = max(0, selected->rect.y);
+// The board fills the largest square that fits in the window.
+void Board::check_layout() {
+	if (win.size() == layout_size) return;
 
-		if (selected->rect.x + selected->rect.w > win_size.first) x = win_size.first - selected->rect.w;
-		if (selected->rect.y + selected->rect.h > win_size.second) y = win_size.first - selected->rect.h;
+	layout_size = win.size();
+	case_size	= static_cast<int>(std::min(layout_size.first / 8, layout_size.second / 8));
 
-		img_renderer.set_coord(x, y);
-		img_renderer.set_size(selected->rect.w, selected->rect.h);
-		img_renderer.render(renderer);
-	} else {
-		throw std::runtime_error("couldn't lock renderer");
+	if (selected) {
+		auto piece_size	 = static_cast<int>(get_piece_size());
+		selected->rect.w = piece_size;
+		selected->rect.h = piece_size;
 	}
 }
 
-void Board::check_pre_rendered(const std::shared_ptr<SDL_Renderer> &renderer) {
-	if (renderer == preRenderedBoardText.first) {
-		return;
-	}
+// Resizing never waits for rasterization: new sprites are made on another thread and swapped in when ready.
+void Board::check_piece_images() {
+	using namespace std::chrono_literals;
 
-	if (renderer != preRenderedBoardText.first) {
-		preRenderedBoardText.second.numbers.clear();
-		preRenderedBoardText.second.letters.clear();
+	if (pending_sprites && pending_sprites->images.wait_for(0s) == std::future_status::ready) {
+		piece_images = std::make_shared<const PieceSprites>(pending_sprites->images.get());
+		sprite_size	 = pending_sprites->size;
+		pending_sprites.reset();
+		win.request_redraw();
 	}
 
-	using graphics::Color;
-
-	preRenderedBoardText.first		  = renderer;
-	PreRenderedBoardText &preRendered = preRenderedBoardText.second;
-	const char			 *letters_str = board.flipped() ? "hgfedcba" : "abcdefgh";
-
-	preRendered.numbers.reserve(8);
-	preRendered.letters.reserve(8);
+	size_t size = get_piece_size();
+	if (pending_sprites || size == sprite_size || size == 0) return;
 
-	for (size_t i = 0; i < 8; i++) {
-		// Numbers initialization
+	std::promise<PieceSprites> promise;
+	auto					   images = promise.get_future();
 
-		preRendered.numbers.emplace_back(renderer, "Segoe UI bold.ttf", 18);
+	// The loop is only woken once the result is stored, so the update that follows finds it ready.
+	auto task = std::async(std::launch::async, [this, size, promise = std::move(promise)]() mutable {
+		try {
+			promise.set_value(load_piece_sprites(size));
+		} catch (...) {
+			promise.set_exception(std::current_exception());
+		}
+		win.request_redraw();
+	});
 
-		preRendered.numbers.back().set_coord(static_cast<size_t>(.06 * case_size),
-			static_cast<size_t>((static_cast<double>(i) + 0.04) * case_size));
-		preRendered.numbers.back().set_content(std::to_string(board.flipped() ? i + 1 : 8 - i));
-		preRendered.numbers.back().set_color(i % 2 ? Color::LIGHT_SQUARE : Color::DARK_SQUARE);
+	pending_sprites.emplace(size, std::move(images), std::move(task));
+}
 
-		preRendered.numbers.back().reload_text();
+void Board::refresh_hints() {
+	using app::game::BLACK;
+	using app::game::WHITE;
 
-		// Letters initialization
+	hanging = app::game::hanging_pieces(board, WHITE) | app::game::hanging_pieces(board, BLACK);
+}
 
-		preRendered.letters.emplace_back(renderer, "Segoe UI bold.ttf", 18);
-		preRendered.letters.back().set_coord(static_cast<size_t>((static_cast<double>(i) + 0.8) * case_size),
-			static_cast<size_t>(7.72 * case_size));
-		preRendered.letters.back().set_content(std::string(1, letters_str[i]));
-		preRendered.letters.back().set_color(i % 2 ? Color::DARK_SQUARE : Color::LIGHT_SQUARE);
+void Board::toggle_hints() {
+	show_hints = !show_hints;
+}
 
-		preRendered.letters.back().reload_text();
-	}
+void Board::invalidate_background() {
+	background_epoch++;
 }
 
 void Board::flip() {
-	preRenderedBoardText.first = nullptr;
+	invalidate_background();
 	board.flip();
 }
 
 void Board::select(size_t x, size_t y) {
 	using Coord = app::game::coord::Agnostic;
 
+	if (!on_board(x, y) || !outcome.empty()) return;
+
 	Coord c(x / case_size, y / case_size);
-	std::cout << "board coordinates: " << c << std::endl;
 
 	auto piece_size = static_cast<int>(get_piece_size());
 
@@ -233,13 +170,22 @@ void Board::drop_selected(size_t x, size_t y) {
 	if (!has_selected()) return;
 
 	if (!selected->moved) {
-		std::cout << selected->coord << " not moved\n";
+		selected.reset();
+		return;
+	}
+
+	// Dropped beside the board: the piece goes back.
+	if (!on_board(x, y)) {
 		selected.reset();
 		return;
 	}
 
 	Coord target(x / case_size, y / case_size);
 	board.move_with_hint(selected->kind, selected->coord, target);
+	refresh_hints();
+
+	if (board.is_draw())
+		outcome = board.halfmove_clock() >= 100 ? "Draw by fifty-move rule" : "Draw by threefold repetition";
 
 	selected.reset();
 }
@@ -250,7 +196,6 @@ bool Board::has_selected() const {
 
 void Board::move_pointer_piece(int x, int y) {
 	using Coord = app::game::coord::Agnostic;
-	using graphics::ImageRenderer;
 
 	if (!has_selected()) return;
 
@@ -260,18 +205,162 @@ void Board::move_pointer_piece(int x, int y) {
 	selected->rect.x = static_cast<int>(x - selected->diff_x);
 	selected->rect.y = static_cast<int>(y - selected->diff_y);
 
+	if (!on_board(x, y)) return;
+
 	Coord c(x / case_size, y / case_size);
 	if (c != selected->coord) {
 		selected->moved = true;
 	}
 }
 
+bool Board::on_board(size_t x, size_t y) const {
+	auto side = static_cast<size_t>(8 * case_size);
+	return x < side && y < side;
+}
+
 graphics::window::Coord Board::gen_sprite_coord(size_t x, size_t y) const {
-	const double shift = case_size * 0.1;
-	return {
-		.x = static_cast<size_t>((static_cast<double>(x) * case_size) + shift),
-		.y = static_cast<size_t>((static_cast<double>(y) * case_size) + shift),
+	return sprite_coord(case_size, x, y);
+}
+
+void BoardView::draw(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame) {
+	if (frame.case_size <= 0 || !frame.sprites) return;
+
+	check_label_glyphs(renderer, frame);
+	check_background(renderer, frame);
+	check_piece_atlas(renderer, frame);
+
+	if (background.texture) {
+		SDL_Rect rect{0, 0, 8 * frame.case_size, 8 * frame.case_size};
+		SDL_RenderCopy(renderer.get(), background.texture.get(), nullptr, &rect);
+	} else {
+		draw_background(renderer, frame);
+	}
+
+	draw_hints(renderer, frame);
+	draw_pieces(renderer, frame);
+	draw_outcome(renderer, frame);
+}
+
+void BoardView::draw_background(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame) const {
+	draw_squares(renderer, frame.case_size);
+	if (label_glyphs.atlas) draw_labels(renderer, *label_glyphs.atlas, frame.case_size, frame.position.flipped);
+}
+
+void BoardView::draw_hints(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame) const {
+	using namespace app::game::bitboard;
+	using graphics::Color;
+
+	auto fill = [&renderer, &frame](Bitboard squares, const Color &col) {
+		SDL_SetRenderDrawColor(renderer.get(), col.r(), col.g(), col.b(), col.a());
+
+		while (squares) {
+			Square s = pop_lsb(squares);
+			int	   x = file_of(s);
+			int	   y = row_of(s);
+
+			if (frame.position.flipped) {
+				x = 7 - x;
+				y = 7 - y;
+			}
+
+			SDL_Rect rect{x * frame.case_size, y * frame.case_size, frame.case_size, frame.case_size};
+			SDL_RenderFillRect(renderer.get(), &rect);
+		}
+	};
+
+	SDL_SetRenderDrawBlendMode(renderer.get(), SDL_BLENDMODE_BLEND);
+	fill(frame.checked, Color::KING_IN_CHECK);
+	fill(frame.hanging, Color::HANGING_PIECE);
+	SDL_SetRenderDrawBlendMode(renderer.get(), SDL_BLENDMODE_NONE);
+}
+
+void BoardView::draw_pieces(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame) const {
+	if (!piece_atlas.atlas) return;
+
+	std::vector<SpriteAtlas::Sprite> sprites;
+	sprites.reserve(33);
+
+	add_piece_sprites(frame.position, frame.case_size, sprites);
+
+	// The dragged piece goes last so it is drawn above the others.
+	if (frame.dragged) sprites.push_back(*frame.dragged);
+
+	piece_atlas.atlas->draw(renderer, sprites);
+}
+
+// The result of a finished game, on a band across the middle of the board.
+void BoardView::draw_outcome(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame) const {
+	if (frame.outcome.empty() || !label_glyphs.atlas) return;
+
+	auto [w, h] = label_glyphs.atlas->measure(frame.outcome);
+
+	int		 side = 8 * frame.case_size;
+	SDL_Rect band{0, (side - 2 * h) / 2, side, 2 * h};
+
+	SDL_SetRenderDrawBlendMode(renderer.get(), SDL_BLENDMODE_BLEND);
+	SDL_SetRenderDrawColor(renderer.get(), 0, 0, 0, 170);
+	SDL_RenderFillRect(renderer.get(), &band);
+	SDL_SetRenderDrawBlendMode(renderer.get(), SDL_BLENDMODE_NONE);
+
+	GlyphAtlas::Text text{
+		.content = frame.outcome,
+		.x		 = (side - w) / 2,
+		.y		 = (side - h) / 2,
+		.color	 = Color(255, 255, 255),
 	};
+	label_glyphs.atlas->draw(renderer, std::span(&text, 1));
+}
+
+void BoardView::check_label_glyphs(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame) {
+	if (renderer == label_glyphs.renderer && frame.case_size == label_glyphs.case_size) {
+		return;
+	}
+
+	label_glyphs.atlas.reset();
+	label_glyphs.atlas.emplace(renderer, "Segoe UI bold.ttf", label_font_size(frame.case_size));
+	label_glyphs.renderer  = renderer;
+	label_glyphs.case_size = frame.case_size;
+}
+
+// Without render target support, the background is drawn square by square every frame instead.
+void BoardView::check_background(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame) {
+	if (renderer == background.renderer && frame.case_size == background.case_size &&
+		frame.position.flipped == background.flipped && frame.background_epoch == background.epoch) {
+		return;
+	}
+
+	background.renderer	 = renderer;
+	background.case_size = frame.case_size;
+	background.flipped	 = frame.position.flipped;
+	background.epoch	 = frame.background_epoch;
+	background.texture.reset();
+
+	if (SDL_RenderTargetSupported(renderer.get()) != SDL_TRUE) return;
+
+	int side = 8 * frame.case_size;
+	background.texture.reset(
+		SDL_CreateTexture(renderer.get(), SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, side, side),
+		SDL_DestroyTexture);
+	if (!background.texture) return;
+
+	if (SDL_SetRenderTarget(renderer.get(), background.texture.get()) != 0) {
+		background.texture.reset();
+		return;
+	}
+
+	draw_background(renderer, frame);
+	SDL_SetRenderTarget(renderer.get(), nullptr);
+}
+
+void BoardView::check_piece_atlas(const std::shared_ptr<SDL_Renderer> &renderer, const Frame &frame) {
+	if (renderer == piece_atlas.renderer && frame.sprites == piece_atlas.sprites) {
+		return;
+	}
+
+	piece_atlas.atlas.reset();
+	piece_atlas.atlas.emplace(make_piece_atlas(renderer, *frame.sprites));
+	piece_atlas.renderer = renderer;
+	piece_atlas.sprites	 = frame.sprites;
 }
 
 Chess::Chess(graphics::window::Window &window)
@@ -279,12 +368,25 @@ Chess::Chess(graphics::window::Window &window)
 	  board(window, false) {
 }
 
+// Main thread: the game state is published for the render thread after every update.
 void Chess::update() {
 	board.update();
+
+	frames.back() = board.snapshot();
+	frames.publish();
 }
 
-void Chess::draw() const {
-	board.draw();
+// Render thread.
+void Chess::draw() {
+	if (auto renderer = win.get_renderer().lock()) {
+		view.draw(renderer, frames.latest());
+	} else {
+		throw std::runtime_error("couldn't lock renderer");
+	}
+}
+
+void Chess::release_renderer() {
+	view = BoardView();
 }
 
 void Chess::handle_events(const SDL_Event &e) {
@@ -297,19 +399,32 @@ void Chess::handle_events(const SDL_Event &e) {
 
 				case SDLK_f:
 					board.flip();
+					win.request_redraw();
+					break;
+
+				case SDLK_h:
+					board.toggle_hints();
+					win.request_redraw();
 					break;
 			}
 			break;
+		case SDL_RENDER_TARGETS_RESET:
+			// The content of target textures is lost.
+			board.invalidate_background();
+			win.request_redraw();
+			break;
 		case SDL_MOUSEBUTTONDOWN:
 			switch (e.button.button) {
 				case SDL_BUTTON_LEFT:
 					board.select(e.button.x, e.button.y);
+					win.request_redraw();
 					break;
 			}
 			break;
 		case SDL_MOUSEMOTION:
 			if (board.has_selected()) {
 				board.move_pointer_piece(e.motion.x, e.motion.y);
+				win.request_redraw();
 			}
 
 			break;
@@ -317,6 +432,7 @@ void Chess::handle_events(const SDL_Event &e) {
 			switch (e.button.button) {
 				case SDL_BUTTON_LEFT:
 					board.drop_selected(e.button.x, e.button.y);
+					win.request_redraw();
 					break;
 			}
 			break;
@@ -0,0 +1,99 @@
+#include "graphics/glyphs.hpp"
+
+#include <SDL_ttf.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace graphics {
+
+GlyphAtlas::GlyphAtlas(const std::shared_ptr<SDL_Renderer> &renderer,
+	const std::filesystem::path							   &font_path,
+	size_t													font_size)
+	: font(app::resources::ResourceManager<app::resources::Font>::get()->make(font_path, font_size)),
+	  sizes{},
+	  advances{},
+	  line_skip(0),
+	  atlas(rasterize(renderer)) {
+}
+
+// Glyphs are rendered white so that the vertex color gives the text its color.
+SpriteAtlas GlyphAtlas::rasterize(const std::shared_ptr<SDL_Renderer> &renderer) {
+	auto f = font->get().lock();
+	if (!f) throw std::runtime_error("no font available: font did expire");
+
+	typedef std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> SurfacePtr;
+
+	constexpr SDL_Color		   WHITE{255, 255, 255, SDL_ALPHA_OPAQUE};
+	std::vector<SurfacePtr>	   owned;
+	std::vector<SDL_Surface *> surfaces;
+
+	line_skip = TTF_FontLineSkip(f.get());
+
+	for (size_t i = 0; i < GLYPH_NB; i++) {
+		auto	   c = static_cast<Uint16>(FIRST_GLYPH + i);
+		int		   min_x, max_x, min_y, max_y, advance;
+
+		SurfacePtr glyph(TTF_RenderGlyph_Blended(f.get(), c, WHITE), SDL_FreeSurface);
+		// Blank glyphs such as the space may have nothing to render.
+		if (!glyph) glyph.reset(SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 32, SDL_PIXELFORMAT_RGBA32));
+		if (!glyph) throw SDLException("couldn't render glyph");
+
+		if (TTF_GlyphMetrics(f.get(), c, &min_x, &max_x, &min_y, &max_y, &advance) != 0) advance = glyph->w;
+
+		sizes[i]	= {glyph->w, glyph->h};
+		advances[i] = advance;
+		surfaces.push_back(glyph.get());
+		owned.push_back(std::move(glyph));
+	}
+
+	return {renderer, surfaces};
+}
+
+size_t GlyphAtlas::glyph_index(char c) {
+	if (c < FIRST_GLYPH || c > LAST_GLYPH) c = '?';
+	return static_cast<size_t>(c - FIRST_GLYPH);
+}
+
+void GlyphAtlas::draw(const std::shared_ptr<SDL_Renderer> &renderer, std::span<const Text> texts) const {
+	std::vector<SpriteAtlas::Sprite> sprites;
+
+	for (const auto &text : texts) {
+		auto color = static_cast<SDL_Color>(text.color);
+		int	 x	   = text.x;
+		int	 y	   = text.y;
+
+		for (char c : text.content) {
+			if (c == '\n') {
+				x  = text.x;
+				y += line_skip;
+				continue;
+			}
+
+			size_t i = glyph_index(c);
+			if (c != ' ') sprites.push_back({.index = i, .dst = {x, y, sizes[i].x, sizes[i].y}, .color = color});
+			x += advances[i];
+		}
+	}
+
+	atlas.draw(renderer, sprites);
+}
+
+std::pair<int, int> GlyphAtlas::measure(std::string_view content) const {
+	int width = 0, line = 0, lines = 1;
+
+	for (char c : content) {
+		if (c == '\n') {
+			line = 0;
+			lines++;
+			continue;
+		}
+
+		line  += advances[glyph_index(c)];
+		width  = std::max(width, line);
+	}
+
+	return {width, lines * line_skip};
+}
+
+}  // namespace graphics
@@ -3,33 +3,76 @@
 #include <SDL_image.h>
 #include <SDL_ttf.h>
 
+#include <algorithm>
+#include <chrono>
+#include <string_view>
 #include <utility>
 
 namespace graphics {
 namespace window {
 
+namespace {
+
+// Upper bound on how long the loop sleeps without any event, so update() still runs now and then.
+constexpr int						IDLE_TIMEOUT_MS = 250;
+
+// How often events are polled while the render thread draws, instead of waited for.
+constexpr std::chrono::milliseconds FRAME_POLL_INTERVAL(1);
+
+// Set to 0 in the environment to draw on the main thread even where a render thread would work.
+constexpr const char *RENDER_THREAD_HINT = "CHESS_RENDER_THREAD";
+
+// SDL only lets a thread other than the main one own a renderer on some video drivers. Cocoa, among others,
+// requires all rendering on the main thread.
+bool render_thread_supported() {
+	const char *driver = SDL_GetCurrentVideoDriver();
+	if (driver == nullptr || SDL_GetHintBoolean(RENDER_THREAD_HINT, SDL_TRUE) == SDL_FALSE) return false;
+
+	std::string_view name(driver);
+	return name == "windows" || name == "x11" || name == "wayland";
+}
+
+}  // namespace
+
 Window::Window(std::string window_name, uint32_t width, uint32_t height)
 	: window(nullptr, SDLWindowDeleter()),
 	  renderer(),
 	  name(std::move(window_name)),
 	  w(width),
 	  h(height),
-	  should_quit(false) {
+	  pixel_w(width),
+	  pixel_h(height),
+	  should_quit(false),
+	  dirty(true),
+	  redraw_event(static_cast<Uint32>(-1)),
+	  frame_pending(false),
+	  published_frames(0),
+	  drawn_frames(0),
+	  pending_input(0) {
 }
 
 Window::~Window() {
-	renderer.reset();
+	if (render_thread.joinable()) {
+		should_quit	  = true;
+		frame_pending = true;
+		frame_pending.notify_one();
+		render_thread.join();
+	}
+	release_renderer();
 	window.reset();
 }
 
 void Window::open() {
-	window.reset(SDL_CreateWindow(name.c_str(), 0, 0, static_cast<int>(w), static_cast<int>(h), 0));
+	constexpr Uint32 SDL_window_flags = SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI;
+	window.reset(SDL_CreateWindow(name.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, static_cast<int>(w),
+		static_cast<int>(h), SDL_window_flags));
 	if (window == nullptr) {
 		throw SDLException("couldn't create window");
 	}
 
-	constexpr Uint32 SDL_renderer_flags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC;
-	renderer.reset(SDL_CreateRenderer(window.get(), -1, SDL_renderer_flags), SDLRendererDeleter());
+	refresh_size();
+
+	redraw_event = SDL_RegisterEvents(1);
 }
 
 std::weak_ptr<SDL_Renderer> Window::get_renderer() {
@@ -40,25 +83,195 @@ void Window::quit() {
 	should_quit = true;
 }
 
+void Window::request_redraw() {
+	if (dirty.exchange(true) || redraw_event == static_cast<Uint32>(-1)) return;
+
+	// Wakes the loop up if it is waiting for events.
+	SDL_Event e{};
+	e.type = redraw_event;
+	SDL_PushEvent(&e);
+}
+
+// The main thread handles events and updates the application, which publishes its state for the render thread.
+// Handling input and updating overlap drawing and waiting for vsync; only pumping events waits for the frame
+// being drawn. Where the video driver does not allow rendering elsewhere, frames are drawn on the main thread
+// between updates instead.
 void Window::run() {
+	if (render_thread_supported()) {
+		render_thread = std::thread(&Window::render_loop, this);
+	} else {
+		create_renderer();
+	}
+
 	while (!should_quit) {
-		SDL_SetRenderDrawColor(renderer.get(), 0, 0, 0, SDL_ALPHA_OPAQUE);
-		SDL_RenderClear(renderer.get());
+		Uint32 input = 0;
+
+		gather_events();
 
-		SDL_Event e;
+		for (const auto &event : events) {
+			if (event.type == SDL_KEYDOWN || event.type == SDL_MOUSEMOTION || event.type == SDL_MOUSEBUTTONDOWN ||
+				event.type == SDL_MOUSEBUTTONUP) {
+				if (input == 0) input = event.common.timestamp;
+			}
+		}
+		coalesce_motion();
 
-		while (SDL_PollEvent(&e) != 0) {
-			if (e.type == SDL_QUIT) {
+		for (auto &event : events) {
+			if (event.type == SDL_QUIT) {
 				quit();
-			} else {
-				app->handle_events(e);
+			} else if (event.type == SDL_WINDOWEVENT) {
+				if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) refresh_size();
+				dirty = true;
+			} else if (event.type != redraw_event) {
+				to_pixels(event);
+				app->handle_events(event);
 			}
 		}
 
 		app->update();
-		app->draw();
-		SDL_RenderPresent(renderer.get());
+
+		// Input that did not change anything on screen is not counted.
+		if (!dirty.exchange(false)) continue;
+
+		// A frame not taken yet keeps its older input.
+		Uint32 none = 0;
+		if (input != 0) pending_input.compare_exchange_strong(none, input);
+
+		if (!render_thread.joinable()) {
+			render_frame();
+			continue;
+		}
+
+		published_frames++;
+		frame_pending = true;
+		frame_pending.notify_one();
+	}
+
+	if (render_thread.joinable()) {
+		frame_pending = true;
+		frame_pending.notify_one();
+		render_thread.join();
+	}
+	release_renderer();
+
+	if (render_error) std::rethrow_exception(std::exchange(render_error, nullptr));
+}
+
+// The renderer is created, used and destroyed on this thread only.
+void Window::render_loop() {
+	try {
+		{
+			std::lock_guard lock(sdl_mutex);
+			create_renderer();
+		}
+
+		while (true) {
+			frame_pending.wait(false);
+			if (should_quit) break;
+			frame_pending = false;
+
+			uint64_t frame = published_frames;
+			{
+				std::lock_guard lock(sdl_mutex);
+				render_frame();
+			}
+			drawn_frames = frame;
+		}
+	} catch (...) {
+		render_error = std::current_exception();
+		should_quit	 = true;
+
+		SDL_Event e{};
+		e.type = SDL_QUIT;
+		SDL_PushEvent(&e);
 	}
+
+	std::lock_guard lock(sdl_mutex);
+	release_renderer();
+}
+
+// Pumping events runs SDL's own renderer event watch, which updates the renderer on resize from the pumping
+// thread; SDL renderers are not thread-safe, so pumping and drawing never overlap. While a frame is being drawn
+// the loop polls between short sleeps rather than holding the lock in a blocking wait. Everything queued is
+// then taken at once, so a burst of mouse motion costs one frame.
+void Window::gather_events() {
+	SDL_Event e;
+	bool	  got = false;
+
+	events.clear();
+
+	std::unique_lock lock(sdl_mutex);
+	while (drawn_frames != published_frames && !should_quit && !(got = SDL_PollEvent(&e) != 0)) {
+		lock.unlock();
+		std::this_thread::sleep_for(FRAME_POLL_INTERVAL);
+		lock.lock();
+	}
+
+	if (!got) got = SDL_WaitEventTimeout(&e, dirty ? 0 : IDLE_TIMEOUT_MS) != 0;
+	if (!got) return;
+
+	do {
+		events.push_back(e);
+	} while (SDL_PollEvent(&e) != 0);
+}
+
+void Window::create_renderer() {
+	constexpr Uint32 SDL_renderer_flags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC;
+	renderer.reset(SDL_CreateRenderer(window.get(), -1, SDL_renderer_flags), SDLRendererDeleter());
+	if (renderer == nullptr) {
+		throw SDLException("couldn't create renderer");
+	}
+}
+
+void Window::render_frame() {
+	Uint32 input = pending_input.exchange(0);
+
+	SDL_SetRenderDrawColor(renderer.get(), 0, 0, 0, SDL_ALPHA_OPAQUE);
+	SDL_RenderClear(renderer.get());
+	app->draw();
+	SDL_RenderPresent(renderer.get());
+
+	if (input != 0) latencies.push_back(SDL_GetTicks() - input);
+}
+
+// Lets the application free what it made with the renderer, on the thread that owns it.
+void Window::release_renderer() {
+	if (!renderer) return;
+
+	if (app) app->release_renderer();
+	renderer.reset();
+}
+
+// Only the last of consecutive motion events is handed to the application, with the relative motion of all
+// of them.
+void Window::coalesce_motion() {
+	auto last = events.end();
+
+	for (auto it = events.begin(); it != events.end(); ++it) {
+		if (it->type == SDL_MOUSEMOTION && last != events.end() && last->type == SDL_MOUSEMOTION) {
+			it->motion.xrel += last->motion.xrel;
+			it->motion.yrel += last->motion.yrel;
+			last->type = SDL_FIRSTEVENT;
+		}
+		last = it;
+	}
+
+	std::erase_if(events, [](const SDL_Event &e) { return e.type == SDL_FIRSTEVENT; });
+}
+
+LatencyStats Window::latency() const {
+	LatencyStats stats{.frames = latencies.size(), .p50 = 0, .p90 = 0, .p99 = 0, .max = 0};
+	if (latencies.empty()) return stats;
+
+	auto sorted	  = latencies;
+	auto quantile = [&sorted](size_t percent) { return sorted[(sorted.size() - 1) * percent / 100]; };
+
+	std::sort(sorted.begin(), sorted.end());
+	stats.p50 = quantile(50);
+	stats.p90 = quantile(90);
+	stats.p99 = quantile(99);
+	stats.max = sorted.back();
+	return stats;
 }
 
 void Window::bind_app(std::unique_ptr<app::Application> app_obj) {
@@ -66,7 +279,36 @@ void Window::bind_app(std::unique_ptr<app::Application> app_obj) {
 }
 
 std::pair<size_t, size_t> Window::size() const {
-	return std::make_pair(w, h);
+	return std::make_pair(pixel_w, pixel_h);
+}
+
+void Window::refresh_size() {
+	int width, height;
+
+	SDL_GetWindowSize(window.get(), &width, &height);
+	w = static_cast<uint32_t>(width);
+	h = static_cast<uint32_t>(height);
+
+	SDL_GetWindowSizeInPixels(window.get(), &width, &height);
+	pixel_w = static_cast<uint32_t>(width);
+	pixel_h = static_cast<uint32_t>(height);
+}
+
+void Window::to_pixels(SDL_Event &e) const {
+	if (w == 0 || h == 0 || (w == pixel_w && h == pixel_h)) return;
+
+	auto scale_x = [this](Sint32 x) { return static_cast<Sint32>(static_cast<int64_t>(x) * pixel_w / w); };
+	auto scale_y = [this](Sint32 y) { return static_cast<Sint32>(static_cast<int64_t>(y) * pixel_h / h); };
+
+	if (e.type == SDL_MOUSEMOTION) {
+		e.motion.x	  = scale_x(e.motion.x);
+		e.motion.y	  = scale_y(e.motion.y);
+		e.motion.xrel = scale_x(e.motion.xrel);
+		e.motion.yrel = scale_y(e.motion.yrel);
+	} else if (e.type == SDL_MOUSEBUTTONDOWN || e.type == SDL_MOUSEBUTTONUP) {
+		e.button.x = scale_x(e.button.x);
+		e.button.y = scale_y(e.button.y);
+	}
 }
 
 void Window::SDLWindowDeleter::operator()(SDL_Window *win) const {
@@ -170,5 +412,7 @@ Color::operator SDL_Color() const {
 
 const Color Color::LIGHT_SQUARE(237, 214, 175);
 const Color Color::DARK_SQUARE(184, 135, 97);
+const Color Color::HANGING_PIECE(214, 48, 49, 110);
+const Color Color::KING_IN_CHECK(235, 59, 90, 190);
 
 }  // namespace graphics
@@ -1,11 +1,17 @@
 #include <iostream>
 #include <vector>
 
+#include "game/bitbase.hpp"
+#include "game/bitboard.hpp"
 #include "game/game.hpp"
 #include "graphics/game.hpp"
 #include "graphics/window.hpp"
+#include "resources.hpp"
 
 int init() {
+	app::game::bitboard::init();
+	app::game::bitbase::init();
+
 	try {
 		graphics::window::init();
 	} catch (const graphics::SDLException& e) {
@@ -27,6 +33,17 @@ int main() {
 			win.bind_app(std::make_unique<graphics::game::Chess>(win));
 			win.open();
 			win.run();
+
+			auto latency = win.latency();
+			std::clog << "input latency over " << latency.frames << " frames: p50 " << latency.p50 << " ms, p90 "
+					  << latency.p90 << " ms, p99 " << latency.p99 << " ms, max " << latency.max << " ms\n";
+
+			auto fonts	= app::resources::ResourceManager<app::resources::Font>::get()->stats();
+			auto images = app::resources::ResourceManager<app::resources::Image>::get()->stats();
+			std::clog << "fonts: " << fonts.loads << " loads, " << fonts.hits << " shared, " << fonts.alive
+					  << " alive (" << fonts.bytes << " bytes)\n"
+					  << "images: " << images.loads << " loads, " << images.hits << " shared, " << images.alive
+					  << " alive (" << images.bytes << " bytes)" << std::endl;
 		} catch (const std::exception& e) {
 			std::cerr << "caught exception: " << e.what() << std::endl;
 			return EXIT_FAILURE;
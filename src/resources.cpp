@@ -1,12 +1,106 @@
 #include "resources.hpp"
 
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <functional>
 #include <sstream>
+#include <thread>
 
 #include "graphics/window.hpp"
 
+#if defined(__unix__) || defined(__APPLE__)
+	#include <unistd.h>
+#elif defined(_WIN32)
+	#include <process.h>
+#endif
+
 namespace app::resources {
 
+namespace {
+
+long process_id() {
+#if defined(__unix__) || defined(__APPLE__)
+	return static_cast<long>(getpid());
+#elif defined(_WIN32)
+	return static_cast<long>(_getpid());
+#else
+	return 0;
+#endif
+}
+
+// Rasterized sprites are stored as raw RGBA32 pixels behind this header.
+struct PixelCacheHeader {
+	char	 magic[8];
+	uint32_t w;
+	uint32_t h;
+};
+
+constexpr char PIXEL_CACHE_MAGIC[8] = {'C', 'H', 'E', 'S', 'S', 'P', 'X', '1'};
+
+uint64_t fnv1a(const std::string &data) {
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	for (unsigned char c : data) hash = (hash ^ c) * 0x100000001B3ULL;
+	return hash;
+}
+
+std::filesystem::path pixel_cache_dir() {
+	if (const char *xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) return std::filesystem::path(xdg) / "chess";
+	if (const char *home = std::getenv("HOME"); home && *home) return std::filesystem::path(home) / ".cache" / "chess";
+	return std::filesystem::temp_directory_path() / "chess";
+}
+
+std::shared_ptr<SDL_Surface> load_cached_pixels(const std::filesystem::path &path, size_t w, size_t h) {
+	std::ifstream ifs(path, std::ios::binary);
+	if (!ifs) return nullptr;
+
+	PixelCacheHeader header{};
+	if (!ifs.read(reinterpret_cast<char *>(&header), sizeof(header))) return nullptr;
+	if (std::memcmp(header.magic, PIXEL_CACHE_MAGIC, sizeof(header.magic)) != 0 || header.w != w || header.h != h)
+		return nullptr;
+
+	std::shared_ptr<SDL_Surface> surface(
+		SDL_CreateRGBSurfaceWithFormat(0, static_cast<int>(w), static_cast<int>(h), 32, SDL_PIXELFORMAT_RGBA32),
+		SDL_FreeSurface);
+	if (!surface) return nullptr;
+
+	auto *pixels = static_cast<char *>(surface->pixels);
+	for (size_t y = 0; y < h; y++) {
+		if (!ifs.read(pixels + y * surface->pitch, static_cast<std::streamsize>(4 * w))) return nullptr;
+	}
+
+	return surface;
+}
+
+// Best effort: a sprite that can't be cached is simply rasterized again next time.
+void store_cached_pixels(const std::filesystem::path &path, const SDL_Surface &surface) {
+	std::error_code ec;
+	std::filesystem::create_directories(path.parent_path(), ec);
+	if (ec) return;
+
+	// Written aside and renamed, so a concurrent launch never reads a partial file. Thread ids repeat across
+	// processes, hence the process id in the name too.
+	auto tmp = path;
+	tmp		+= ".tmp" + std::to_string(process_id());
+	tmp		+= '-' + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+	std::ofstream	 ofs(tmp, std::ios::binary);
+	PixelCacheHeader header{};
+	std::memcpy(header.magic, PIXEL_CACHE_MAGIC, sizeof(header.magic));
+	header.w = static_cast<uint32_t>(surface.w);
+	header.h = static_cast<uint32_t>(surface.h);
+	ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+	const auto *pixels = static_cast<const char *>(surface.pixels);
+	for (int y = 0; y < surface.h; y++) ofs.write(pixels + y * surface.pitch, 4 * surface.w);
+
+	ofs.close();
+	if (ofs) std::filesystem::rename(tmp, path, ec);
+	if (!ofs || ec) std::filesystem::remove(tmp, ec);
+}
+
+}  // namespace
+
 std::shared_ptr<ResourceManager<Font> > font_manager = ResourceManager<Font>::get();
 
 Font::Font(std::filesystem::path file, uint8_t font_size)
@@ -15,8 +109,11 @@ Font::Font(std::filesystem::path file, uint8_t font_size)
 	load();
 }
 
+// Copies share the loaded font instead of opening the file again.
 Font::Font(const Font& other)
-	: Font(other.filename, other.size) {
+	: filename(other.filename),
+	  size(other.size),
+	  font(other.font) {
 }
 
 Font& Font::operator=(const Font& other) {
@@ -24,7 +121,7 @@ Font& Font::operator=(const Font& other) {
 
 	size	 = other.size;
 	filename = other.filename;
-	load();
+	font	 = other.font;
 
 	return *this;
 }
@@ -33,6 +130,12 @@ std::weak_ptr<TTF_Font> Font::get() const {
 	return {font};
 }
 
+size_t Font::memory_usage() const {
+	std::error_code ec;
+	auto			bytes = std::filesystem::file_size(filename, ec);
+	return ec ? 0 : static_cast<size_t>(bytes);
+}
+
 std::filesystem::path Font::get_subroot() {
 	return "fonts";
 }
@@ -52,11 +155,12 @@ Image::Image(std::filesystem::path file, size_t _w, size_t _h)
 	load();
 }
 
+// Copies share the surface instead of loading the file again.
 Image::Image(const Image& other)
 	: filename(other.filename),
+	  image(other.image),
 	  w(other.w),
 	  h(other.h) {
-	load();
 }
 
 Image& Image::operator=(const Image& other) {
@@ -65,9 +169,9 @@ Image& Image::operator=(const Image& other) {
 	}
 
 	filename = other.filename;
+	image	 = other.image;
 	w		 = other.w;
 	h		 = other.h;
-	load();
 	return *this;
 }
 
@@ -79,12 +183,14 @@ std::filesystem::path Image::get_subroot() {
 	return "sprites";
 }
 
+// Sized SVG sprites go through an on-disk cache of their pixels, keyed by the SVG content and the size, as
+// rasterizing them dominates startup.
 void Image::load() {
 	image.reset();
 
 	if (filename.extension() == ".svg") {
 		std::string	  content;
-		std::ifstream ifs(filename);
+		std::ifstream ifs(filename, std::ios::binary);
 
 		if (ifs) {
 			std::ostringstream oss;
@@ -92,10 +198,23 @@ void Image::load() {
 			content = oss.str();
 		}
 
-		SDL_RWops* rw = SDL_RWFromConstMem(content.c_str(), static_cast<int>(content.length()));
 		if (w != 0 && h != 0) {
-			image.reset(IMG_LoadSizedSVG_RW(rw, static_cast<int>(w), static_cast<int>(h)), SDL_FreeSurface);
+			std::ostringstream key;
+			key << std::hex << fnv1a(content) << std::dec << '-' << w << 'x' << h << ".rgba";
+			auto cached = pixel_cache_dir() / "sprites" / key.str();
+
+			if ((image = load_cached_pixels(cached, w, h))) return;
+
+			SDL_RWops *rw = SDL_RWFromConstMem(content.c_str(), static_cast<int>(content.length()));
+			std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> raster(
+				IMG_LoadSizedSVG_RW(rw, static_cast<int>(w), static_cast<int>(h)), SDL_FreeSurface);
+			if (!raster) throw graphics::SDLException("couldn't load image sprite");
+
+			image.reset(SDL_ConvertSurfaceFormat(raster.get(), SDL_PIXELFORMAT_RGBA32, 0), SDL_FreeSurface);
+			if (image && image->w == static_cast<int>(w) && image->h == static_cast<int>(h))
+				store_cached_pixels(cached, *image);
 		} else {
+			SDL_RWops *rw = SDL_RWFromConstMem(content.c_str(), static_cast<int>(content.length()));
 			image.reset(IMG_LoadSVG_RW(rw), SDL_FreeSurface);
 		}
 	} else {
@@ -109,4 +228,8 @@ std::weak_ptr<SDL_Surface> Image::get() const {
 	return {image};
 }
 
+size_t Image::memory_usage() const {
+	return image ? static_cast<size_t>(image->pitch) * static_cast<size_t>(image->h) : 0;
+}
+
 }  // namespace app::resources
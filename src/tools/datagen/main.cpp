@@ -0,0 +1,168 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "engine/search.hpp"
+#include "game/bitbase.hpp"
+#include "game/bitboard.hpp"
+#include "game/movegen.hpp"
+#include "tools/training_data.hpp"
+
+namespace {
+
+using namespace app::game;
+using namespace app::engine;
+
+struct Options {
+	std::string output		 = "selfplay.bin";
+	uint64_t	games		 = 1000;
+	size_t		threads		 = std::max(1U, std::thread::hardware_concurrency());
+	uint64_t	nodes		 = 5000;
+	int			random_plies = 8;
+	uint64_t	seed		 = 1;
+	size_t		hash_mb		 = 8;
+};
+
+// Scores beyond this for a few plies in a row end the game as a win, as does a long game as a draw.
+constexpr int ADJUDICATE_SCORE = 1500;
+constexpr int ADJUDICATE_PLIES = 8;
+constexpr int MAX_GAME_PLIES   = 400;
+
+void usage(const char *name) {
+	std::cerr << "usage: " << name << " [-o file] [-g games] [-t threads] [-n nodes] [-r random plies] [-s seed]\n"
+			  << "  writes 32-byte positions (see tools/training_data.hpp), default selfplay.bin" << std::endl;
+}
+
+// Plays random legal moves from the start position; false when the game ended during the opening.
+bool random_opening(Board &board, std::mt19937_64 &rng, int plies) {
+	board.set_fen(Board::START_FEN);
+
+	for (int ply = 0; ply < plies; ply++) {
+		MoveList<> moves;
+		generate<LEGAL>(board, moves);
+		if (moves.empty()) return false;
+
+		board.do_move(moves[rng() % moves.size()].move);
+	}
+
+	MoveList<> moves;
+	generate<LEGAL>(board, moves);
+	return !moves.empty();
+}
+
+// One game at a fixed node count per move. Quiet positions out of check are kept with the search score;
+// the result is filled in once the game is over.
+std::vector<tools::TrainingEntry> play_game(Board &board, Search &search, TranspositionTable &tt,
+											std::mt19937_64 &rng, const Options &options) {
+	std::vector<tools::TrainingEntry> entries;
+
+	// An extra random ply half of the time spreads the openings over both sides to move.
+	int								  ply = options.random_plies + static_cast<int>(rng() & 1);
+	if (!random_opening(board, rng, ply)) return entries;
+
+	tt.clear();
+
+	Limits limits;
+	limits.nodes	   = options.nodes;
+
+	int result		   = 0;
+	int decisive_plies = 0;
+
+	for (;; ply++) {
+		MoveList<> moves;
+		generate<LEGAL>(board, moves);
+
+		if (moves.empty()) {
+			result = board.in_check(board.side_to_move()) ? (board.side_to_move() == WHITE ? -1 : 1) : 0;
+			break;
+		}
+		if (board.is_draw() || ply >= MAX_GAME_PLIES) break;
+
+		Info info	   = search.run(board, limits);
+		Move best	   = info.pv[0];
+		int	 white	   = board.side_to_move() == WHITE ? info.score : -info.score;
+
+		decisive_plies = std::abs(info.score) >= ADJUDICATE_SCORE ? decisive_plies + 1 : 0;
+		if (decisive_plies >= ADJUDICATE_PLIES) {
+			result = white > 0 ? 1 : -1;
+			break;
+		}
+
+		bool quiet = board.piece_on(best.to()) == NO_PIECE && best.flag() == Move::NORMAL;
+		if (quiet && !board.in_check(board.side_to_move()) && std::abs(info.score) < VALUE_MATE_IN_MAX_PLY)
+			entries.push_back(tools::pack(board, ply, info.score, 0));
+
+		board.do_move(best);
+	}
+
+	for (auto &entry : entries) entry.result = static_cast<int8_t>(result);
+	return entries;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+	Options options;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+
+		if (arg == "-o" && i + 1 < argc) options.output = argv[++i];
+		else if (arg == "-g" && i + 1 < argc) options.games = std::stoull(argv[++i]);
+		else if (arg == "-t" && i + 1 < argc) options.threads = std::max(1UL, std::stoul(argv[++i]));
+		else if (arg == "-n" && i + 1 < argc) options.nodes = std::stoull(argv[++i]);
+		else if (arg == "-r" && i + 1 < argc) options.random_plies = std::stoi(argv[++i]);
+		else if (arg == "-s" && i + 1 < argc) options.seed = std::stoull(argv[++i]);
+		else return usage(argv[0]), EXIT_FAILURE;
+	}
+
+	bitboard::init();
+	bitbase::init();
+
+	tools::TrainingWriter writer(options.output);
+	std::atomic<uint64_t> next_game(0);
+	std::mutex			  progress_mutex;
+	auto				  start = std::chrono::steady_clock::now();
+
+	// Each worker owns its board, table and search and takes the next game number until none are left; the
+	// game number seeds the opening, so a run is reproducible whatever the thread count.
+	auto worker = [&] {
+		Board			   board(false);
+		TranspositionTable tt;
+		Search			   search(tt);
+
+		tt.resize(options.hash_mb);
+
+		for (uint64_t game; (game = next_game++) < options.games;) {
+			std::mt19937_64 rng(options.seed * 0x9E3779B97F4A7C15ULL + game);
+			auto			entries = play_game(board, search, tt, rng, options);
+
+			writer.write(entries);
+
+			if ((game + 1) % 100 == 0) {
+				auto   elapsed = std::chrono::steady_clock::now() - start;
+				double hours   = std::chrono::duration<double>(elapsed).count() / 3600;
+
+				std::lock_guard lock(progress_mutex);
+				std::cout << "games " << game + 1 << "  positions " << writer.written() << "  positions/h/core "
+						  << static_cast<uint64_t>(static_cast<double>(writer.written()) / hours / options.threads)
+						  << std::endl;
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < options.threads; i++) threads.emplace_back(worker);
+	for (auto &thread : threads) thread.join();
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << options.games << " games, " << writer.written() << " positions in " << seconds << " s" << std::endl;
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_ttf.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "game/bitboard.hpp"
+#include "game/game.hpp"
+#include "graphics/drawing.hpp"
+
+namespace {
+
+struct Options {
+	std::filesystem::path output  = "diagrams";
+	int					  square  = 60;
+	size_t				  threads = std::max(1U, std::thread::hardware_concurrency());
+	bool				  labels  = true;
+};
+
+// A software renderer drawing into its own surface. Renderers are not shared between threads, the sprite
+// surfaces behind the atlases are.
+struct Canvas {
+	std::shared_ptr<SDL_Surface>		 surface;
+	std::shared_ptr<SDL_Renderer>		 renderer;
+	std::optional<graphics::SpriteAtlas> pieces;
+	std::optional<graphics::GlyphAtlas>	 glyphs;
+};
+
+void usage(const char *name) {
+	std::cerr << "usage: " << name << " [-o directory] [-s square size] [-t threads] [-nolabels] <fen file>\n"
+			  << "  writes one PNG per FEN line, named after the line number" << std::endl;
+}
+
+Canvas make_canvas(const Options &options, const graphics::game::PieceSprites &sprites) {
+	Canvas canvas;
+	int	   side = 8 * options.square;
+
+	canvas.surface.reset(SDL_CreateRGBSurfaceWithFormat(0, side, side, 32, SDL_PIXELFORMAT_RGBA32), SDL_FreeSurface);
+	if (!canvas.surface) throw graphics::SDLException("couldn't create diagram surface");
+
+	canvas.renderer.reset(SDL_CreateSoftwareRenderer(canvas.surface.get()), SDL_DestroyRenderer);
+	if (!canvas.renderer) throw graphics::SDLException("couldn't create software renderer");
+
+	canvas.pieces.emplace(graphics::game::make_piece_atlas(canvas.renderer, sprites));
+	if (options.labels) {
+		canvas.glyphs.emplace(canvas.renderer, "Segoe UI bold.ttf", graphics::game::label_font_size(options.square));
+	}
+
+	return canvas;
+}
+
+void draw(Canvas &canvas, const app::game::Board &board, int square) {
+	std::vector<graphics::SpriteAtlas::Sprite> sprites;
+
+	SDL_SetRenderDrawBlendMode(canvas.renderer.get(), SDL_BLENDMODE_NONE);
+	graphics::game::draw_squares(canvas.renderer, square);
+	if (canvas.glyphs) graphics::game::draw_labels(canvas.renderer, *canvas.glyphs, square, board.flipped());
+
+	graphics::game::add_piece_sprites(graphics::game::Position(board), square, sprites);
+	canvas.pieces->draw(canvas.renderer, sprites);
+
+	SDL_RenderFlush(canvas.renderer.get());
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+	Options		options;
+	std::string input;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+
+		if (arg == "-o" && i + 1 < argc) options.output = argv[++i];
+		else if (arg == "-s" && i + 1 < argc) options.square = std::max(8, std::stoi(argv[++i]));
+		else if (arg == "-t" && i + 1 < argc) options.threads = std::max(1UL, std::stoul(argv[++i]));
+		else if (arg == "-nolabels") options.labels = false;
+		else if (!arg.starts_with('-') && input.empty()) input = arg;
+		else return usage(argv[0]), EXIT_FAILURE;
+	}
+
+	if (input.empty()) return usage(argv[0]), EXIT_FAILURE;
+
+	std::vector<std::string> fens;
+	std::ifstream			 file(input);
+	if (!file) {
+		std::cerr << "cannot open " << input << std::endl;
+		return EXIT_FAILURE;
+	}
+	for (std::string line; std::getline(file, line);) fens.push_back(line);
+
+	app::game::bitboard::init();
+
+	if (TTF_Init() != 0 || IMG_Init(IMG_INIT_PNG) == 0) {
+		std::cerr << "unable to initialize SDL_ttf or SDL_image: " << SDL_GetError() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::error_code ec;
+	std::filesystem::create_directories(options.output, ec);
+
+	std::atomic<size_t>					  next(0), written(0), failed(0);
+	std::vector<Canvas>					  canvases;
+	std::chrono::steady_clock::time_point start;
+
+	try {
+		// Sprites are rasterized once for every thread. Atlases and glyphs are made here, one after another,
+		// as SDL_ttf and the atlas packing are not meant to run concurrently.
+		auto sprites = graphics::game::load_piece_sprites(graphics::game::piece_size(options.square));
+		for (size_t i = 0; i < options.threads; i++) canvases.push_back(make_canvas(options, sprites));
+
+		auto worker = [&](Canvas &canvas) {
+			app::game::Board board(true);
+
+			for (size_t i; (i = next++) < fens.size();) {
+				if (fens[i].empty()) continue;
+
+				char name[32];
+				std::snprintf(name, sizeof(name), "%06zu.png", i + 1);
+
+				try {
+					board.set_fen(fens[i]);
+				} catch (const app::game::InvalidFenException &e) {
+					std::cerr << input << ":" << i + 1 << ": " << e.what() << std::endl;
+					failed++;
+					continue;
+				}
+
+				draw(canvas, board, options.square);
+
+				if (IMG_SavePNG(canvas.surface.get(), (options.output / name).c_str()) != 0) {
+					std::cerr << name << ": " << SDL_GetError() << std::endl;
+					failed++;
+				} else {
+					written++;
+				}
+			}
+		};
+
+		start = std::chrono::steady_clock::now();
+
+		std::vector<std::thread> threads;
+		for (auto &canvas : canvases) threads.emplace_back(worker, std::ref(canvas));
+		for (auto &thread : threads) thread.join();
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << written << " diagrams in " << seconds << " s (" << static_cast<double>(written) / seconds
+			  << " diagrams/s on " << options.threads << " threads)";
+	if (failed) std::cout << ", " << failed << " failed";
+	std::cout << std::endl;
+
+	canvases.clear();
+	IMG_Quit();
+	TTF_Quit();
+
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "game/bitboard.hpp"
+#include "tools/match.hpp"
+
+namespace {
+
+void usage(const char *name) {
+	std::cerr << "usage: " << name << " [options] <engine> <baseline>\n"
+			  << "  -tc <s>[+<inc>]      time control in seconds, default 10+0.1\n"
+			  << "  -c <n>               games played at once, default 1\n"
+			  << "  -g <n>               maximum number of games, default 1000\n"
+			  << "  -openings <file>     one FEN per line, each played with both colors\n"
+			  << "  -plies <n>           random opening plies when there is no file, default 8\n"
+			  << "  -seed <n>            seed of the random openings\n"
+			  << "  -sprt <elo0> <elo1>  stop as soon as the test decides, alpha = beta = 0.05\n"
+			  << "  -option <name=value> UCI option sent to both engines" << std::endl;
+}
+
+// "10+0.1" into milliseconds.
+bool parse_time_control(const std::string &tc, tools::MatchConfig &config) {
+	size_t plus = tc.find('+');
+
+	try {
+		config.base_ms = static_cast<int64_t>(std::stod(tc.substr(0, plus)) * 1000);
+		config.inc_ms  = plus == std::string::npos ? 0 : static_cast<int64_t>(std::stod(tc.substr(plus + 1)) * 1000);
+	} catch (const std::logic_error &) {
+		return false;
+	}
+
+	return config.base_ms > 0;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+	tools::MatchConfig config;
+	size_t			   engines = 0;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg	 = argv[i];
+		bool		more = i + 1 < argc;
+
+		if (arg == "-tc" && more) {
+			if (!parse_time_control(argv[++i], config)) return usage(argv[0]), EXIT_FAILURE;
+		} else if (arg == "-c" && more) {
+			config.concurrency = std::stoul(argv[++i]);
+		} else if (arg == "-g" && more) {
+			config.max_games = std::stoull(argv[++i]);
+		} else if (arg == "-openings" && more) {
+			config.openings = argv[++i];
+		} else if (arg == "-plies" && more) {
+			config.random_plies = std::stoi(argv[++i]);
+		} else if (arg == "-seed" && more) {
+			config.seed = std::stoull(argv[++i]);
+		} else if (arg == "-sprt" && i + 2 < argc) {
+			double elo0 = std::stod(argv[++i]);
+			double elo1 = std::stod(argv[++i]);
+			config.sprt.emplace(elo0, elo1, 0.05, 0.05);
+		} else if (arg == "-option" && more) {
+			config.options.emplace_back(argv[++i]);
+		} else if (!arg.starts_with('-') && engines < 2) {
+			config.commands[engines++] = arg;
+		} else {
+			return usage(argv[0]), EXIT_FAILURE;
+		}
+	}
+
+	if (engines != 2) return usage(argv[0]), EXIT_FAILURE;
+
+	// A crashed engine closes its pipe; that has to show up as a failed write, not end the runner.
+	std::signal(SIGPIPE, SIG_IGN);
+	app::game::bitboard::init();
+
+	try {
+		tools::Match match(config, std::cout);
+		tools::Score score	  = match.run();
+		auto		 estimate = tools::elo(score);
+
+		std::cout << "\n" << config.commands[0] << " vs " << config.commands[1] << ": " << score.wins << " - "
+				  << score.losses << " - " << score.draws << " (" << score.games() << " games)\n";
+		std::cout << "elo " << estimate.elo << " +/- " << estimate.error << " (95%)\n";
+
+		if (config.sprt) {
+			auto decision = config.sprt->decide(score);
+			std::cout << "sprt "
+					  << (decision == tools::Sprt::ACCEPT_H1	? "H1 accepted"
+						  : decision == tools::Sprt::ACCEPT_H0 ? "H0 accepted"
+															   : "inconclusive")
+					  << ", llr " << config.sprt->llr(score) << std::endl;
+		}
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
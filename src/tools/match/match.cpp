@@ -0,0 +1,281 @@
+#include "tools/match.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "game/game.hpp"
+#include "game/movegen.hpp"
+
+namespace tools {
+
+using namespace app::game;
+
+namespace {
+
+constexpr UciEngine::Duration READY_TIMEOUT(10000);
+constexpr int				  MATE_SCORE = 32000;
+
+// Kings alone, or with a single minor piece: no mate is possible.
+bool insufficient_material(const Board &board) {
+	bitboard::Bitboard heavy = board.pieces(PAWN) | board.pieces(ROOK) | board.pieces(QUEEN);
+	return !heavy && std::popcount(board.pieces()) <= 3;
+}
+
+std::optional<Move> parse_move(const Board &board, const std::string &text) {
+	MoveList<> moves;
+	generate<LEGAL>(board, moves);
+
+	for (const auto &[m, score] : moves) {
+		if (m.to_string() == text) return m;
+	}
+
+	return std::nullopt;
+}
+
+// Score of an "info" line from the mover's point of view, mates counting as large scores.
+std::optional<int> parse_score(const std::string &line) {
+	std::istringstream iss(line);
+	std::string		   token;
+
+	while (iss >> token) {
+		if (token != "score") continue;
+
+		int value;
+		iss >> token >> value;
+		if (token == "cp") return value;
+		if (token == "mate") return value > 0 ? MATE_SCORE - value : -MATE_SCORE - value;
+	}
+
+	return std::nullopt;
+}
+
+}  // namespace
+
+Match::Match(MatchConfig match_config, std::ostream &output)
+	: config(std::move(match_config)),
+	  out(output),
+	  next_pair(0),
+	  stopped(false) {
+	if (config.openings.empty()) return;
+
+	std::ifstream file(config.openings);
+	if (!file) throw std::runtime_error("cannot open " + config.openings);
+
+	for (std::string line; std::getline(file, line);) {
+		if (!line.empty()) fens.push_back(line);
+	}
+}
+
+Score Match::run() {
+	std::vector<std::thread> workers;
+	for (size_t i = 0; i < std::max<size_t>(config.concurrency, 1); i++) workers.emplace_back([this] { worker(); });
+	for (auto &w : workers) w.join();
+
+	return score;
+}
+
+// Random openings are generated from the pair number, so both games of a pair and every rerun with the
+// same seed start from the same position.
+std::string Match::opening(uint64_t pair) const {
+	if (!fens.empty()) return fens[pair % fens.size()];
+
+	Board			board(false);
+	std::mt19937_64 rng(config.seed * 0x9E3779B97F4A7C15ULL + pair);
+
+	for (;;) {
+		board.set_fen(Board::START_FEN);
+
+		int ply = 0;
+		for (; ply < config.random_plies; ply++) {
+			MoveList<> moves;
+			generate<LEGAL>(board, moves);
+			if (moves.empty()) break;
+
+			board.do_move(moves[rng() % moves.size()].move);
+		}
+
+		MoveList<> moves;
+		generate<LEGAL>(board, moves);
+		if (ply == config.random_plies && !moves.empty()) return board.fen();
+	}
+}
+
+void Match::worker() {
+	std::array<std::unique_ptr<UciEngine>, 2> engines;
+
+	while (!stopped) {
+		uint64_t pair = next_pair++;
+		if (2 * pair >= config.max_games) break;
+
+		std::string fen = opening(pair);
+
+		for (bool first_is_white : {true, false}) {
+			if (stopped || 2 * pair + !first_is_white >= config.max_games) break;
+
+			std::string reason;
+			Outcome		outcome;
+
+			try {
+				// Engines that crashed or timed out in the previous game are restarted.
+				for (size_t i = 0; i < 2; i++) {
+					if (!engines[i] || !engines[i]->alive()) {
+						engines[i] = std::make_unique<UciEngine>(config.commands[i]);
+						engines[i]->configure(config.options, READY_TIMEOUT);
+					}
+				}
+
+				outcome = play(engines, fen, first_is_white, reason);
+			} catch (const std::exception &e) {
+				std::scoped_lock guard(lock);
+				out << e.what() << std::endl;
+				stopped = true;
+				return;
+			}
+
+			record(outcome, reason);
+		}
+	}
+}
+
+Match::Outcome Match::play(std::array<std::unique_ptr<UciEngine>, 2> &engines, const std::string &opening,
+						   bool first_is_white, std::string &reason) {
+	typedef std::chrono::steady_clock Clock;
+
+	Board board(false);
+	board.set_fen(opening);
+
+	for (auto &engine : engines) {
+		if (!engine->new_game(READY_TIMEOUT)) engine.reset();
+	}
+	if (!engines[0] || !engines[1]) {
+		reason = "engine not ready";
+		return engines[0] ? Outcome::FIRST_WINS : Outcome::SECOND_WINS;
+	}
+
+	// Engine index and clock of each color.
+	std::array<size_t, COLOR_NB>  engine_of;
+	std::array<int64_t, COLOR_NB> clock = {config.base_ms, config.base_ms};
+	engine_of[WHITE]					= first_is_white ? 0 : 1;
+	engine_of[BLACK]					= first_is_white ? 1 : 0;
+
+	auto winner = [&engine_of](Color c) {
+		return engine_of[c] == 0 ? Outcome::FIRST_WINS : Outcome::SECOND_WINS;
+	};
+	auto finish = [&reason](std::string why, Outcome outcome) {
+		reason = std::move(why);
+		return outcome;
+	};
+
+	std::string		 moves;
+	std::vector<int> white_scores;
+
+	for (int ply = 0;; ply++) {
+		MoveList<> legal;
+		generate<LEGAL>(board, legal);
+
+		Color us = board.side_to_move();
+		if (legal.empty()) {
+			return board.in_check(us) ? finish("checkmate", winner(~us)) : finish("stalemate", Outcome::DRAW);
+		}
+		if (board.is_draw()) return finish("repetition or fifty moves", Outcome::DRAW);
+		if (insufficient_material(board)) return finish("insufficient material", Outcome::DRAW);
+		if (ply >= config.max_plies) return finish("move limit", Outcome::DRAW);
+
+		UciEngine &engine = *engines[engine_of[us]];
+		engine.send("position fen " + opening + (moves.empty() ? "" : " moves" + moves));
+		engine.send("go wtime " + std::to_string(clock[WHITE]) + " btime " + std::to_string(clock[BLACK]) +
+					" winc " + std::to_string(config.inc_ms) + " binc " + std::to_string(config.inc_ms));
+
+		auto			   start = Clock::now();
+		auto			   limit = UciEngine::Duration(clock[us] + config.margin_ms);
+		std::optional<int> score;
+		std::string		   best;
+
+		for (;;) {
+			auto left = limit - std::chrono::duration_cast<UciEngine::Duration>(Clock::now() - start);
+			auto line = engine.read_line(std::max(left, UciEngine::Duration(0)));
+
+			if (!line) break;
+			if (line->starts_with("info")) {
+				if (auto s = parse_score(*line)) score = s;
+			} else if (line->starts_with("bestmove")) {
+				std::istringstream iss(*line);
+				iss >> best >> best;
+				break;
+			}
+		}
+
+		auto used  = std::chrono::duration_cast<UciEngine::Duration>(Clock::now() - start).count();
+		clock[us] -= used;
+
+		if (best.empty()) {
+			// Either the engine died or it is still thinking past its time: restart it for the next game.
+			std::string why		   = engine.alive() ? "loss on time" : "engine crashed";
+			engines[engine_of[us]] = nullptr;
+			return finish(why, winner(~us));
+		}
+		if (clock[us] < -config.margin_ms) return finish("loss on time", winner(~us));
+
+		clock[us] += config.inc_ms;
+
+		auto m	   = parse_move(board, best);
+		if (!m) return finish("illegal move " + best, winner(~us));
+
+		board.do_move(*m);
+		moves += ' ' + best;
+
+		// Adjudication looks at the last scores of both engines, kept from white's point of view.
+		white_scores.push_back(score ? (us == WHITE ? *score : -*score) : 0);
+
+		size_t resign_window = 2 * static_cast<size_t>(config.resign_moves);
+		if (white_scores.size() >= resign_window) {
+			auto last = white_scores.end() - static_cast<std::ptrdiff_t>(resign_window);
+			if (std::all_of(last, white_scores.end(), [this](int s) { return s >= config.resign_score; }))
+				return finish("adjudication", winner(WHITE));
+			if (std::all_of(last, white_scores.end(), [this](int s) { return s <= -config.resign_score; }))
+				return finish("adjudication", winner(BLACK));
+		}
+
+		size_t draw_window = 2 * static_cast<size_t>(config.draw_moves);
+		if (ply >= config.draw_after && white_scores.size() >= draw_window) {
+			auto last = white_scores.end() - static_cast<std::ptrdiff_t>(draw_window);
+			if (std::all_of(last, white_scores.end(), [this](int s) { return std::abs(s) <= config.draw_score; }))
+				return finish("adjudication", Outcome::DRAW);
+		}
+	}
+}
+
+void Match::record(Outcome outcome, const std::string &reason) {
+	std::scoped_lock guard(lock);
+
+	if (stopped && config.sprt) return;
+
+	if (outcome == Outcome::FIRST_WINS) score.wins++;
+	else if (outcome == Outcome::SECOND_WINS) score.losses++;
+	else score.draws++;
+
+	constexpr const char *OUTCOMES[] = {"win", "loss", "draw"};
+
+	EloEstimate			  estimate	 = elo(score);
+	out << "game " << score.games() << ": " << OUTCOMES[static_cast<int>(outcome)] << " (" << reason << ")  "
+		<< score.wins << " - " << score.losses << " - " << score.draws << "  elo " << std::lround(estimate.elo)
+		<< " +/- " << std::lround(estimate.error);
+
+	if (config.sprt) {
+		out << "  llr " << config.sprt->llr(score) << " [" << config.sprt->lower_bound() << ", "
+			<< config.sprt->upper_bound() << "]";
+
+		if (config.sprt->decide(score) != Sprt::CONTINUE) stopped = true;
+	}
+
+	out << std::endl;
+}
+
+}  // namespace tools
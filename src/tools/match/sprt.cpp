@@ -0,0 +1,75 @@
+#include "tools/sprt.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace tools {
+
+namespace {
+
+double expected_score(double elo) {
+	return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+double elo_of(double score) {
+	score = std::clamp(score, 1e-6, 1 - 1e-6);
+	return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+// Mean score per game and the variance of a single game's score.
+void moments(const Score &score, double &mean, double &variance) {
+	double n = static_cast<double>(score.games());
+	double w = static_cast<double>(score.wins) / n;
+	double d = static_cast<double>(score.draws) / n;
+	double l = static_cast<double>(score.losses) / n;
+
+	mean	 = w + d / 2;
+	variance = w * (1 - mean) * (1 - mean) + d * (0.5 - mean) * (0.5 - mean) + l * mean * mean;
+}
+
+}  // namespace
+
+EloEstimate elo(const Score &score) {
+	if (!score.games()) return {0, 0};
+
+	double mean, variance;
+	moments(score, mean, variance);
+
+	double margin = 1.959964 * std::sqrt(variance / static_cast<double>(score.games()));
+	return {elo_of(mean), (elo_of(mean + margin) - elo_of(mean - margin)) / 2};
+}
+
+Sprt::Sprt(double elo0, double elo1, double alpha, double beta)
+	: score0(expected_score(elo0)),
+	  score1(expected_score(elo1)),
+	  lower(std::log(beta / (1 - alpha))),
+	  upper(std::log((1 - beta) / alpha)) {
+}
+
+double Sprt::llr(const Score &score) const {
+	if (!score.wins || !score.losses) return 0;
+
+	double mean, variance;
+	moments(score, mean, variance);
+	if (variance <= 0) return 0;
+
+	return static_cast<double>(score.games()) * (score1 - score0) * (2 * mean - score0 - score1) / (2 * variance);
+}
+
+Sprt::Decision Sprt::decide(const Score &score) const {
+	double ratio = llr(score);
+
+	if (ratio >= upper) return ACCEPT_H1;
+	if (ratio <= lower) return ACCEPT_H0;
+	return CONTINUE;
+}
+
+double Sprt::lower_bound() const {
+	return lower;
+}
+
+double Sprt::upper_bound() const {
+	return upper;
+}
+
+}  // namespace tools
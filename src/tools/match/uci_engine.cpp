@@ -0,0 +1,164 @@
+#include "tools/uci_engine.hpp"
+
+#include <csignal>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+namespace tools {
+
+UciEngine::UciEngine(const std::string &command, Duration timeout)
+	: pid(-1),
+	  to_engine(-1),
+	  from_engine(-1),
+	  id(command),
+	  exited(false) {
+	std::istringstream		 iss(command);
+	std::vector<std::string> args;
+	for (std::string arg; iss >> arg;) args.push_back(arg);
+	if (args.empty()) throw std::runtime_error("empty engine command");
+
+	std::vector<char *> argv;
+	for (auto &arg : args) argv.push_back(arg.data());
+	argv.push_back(nullptr);
+
+	// Both ends are close-on-exec so that engines started by other threads do not inherit them; the dup2()
+	// onto stdin and stdout clears the flag in the child.
+	int in[2], out[2];
+	if (pipe2(in, O_CLOEXEC) || pipe2(out, O_CLOEXEC)) throw std::runtime_error("pipe: " + command);
+
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_adddup2(&actions, in[0], STDIN_FILENO);
+	posix_spawn_file_actions_adddup2(&actions, out[1], STDOUT_FILENO);
+
+	int err = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+	posix_spawn_file_actions_destroy(&actions);
+
+	close(in[0]);
+	close(out[1]);
+	to_engine	= in[1];
+	from_engine = out[0];
+
+	if (err) {
+		close(to_engine);
+		close(from_engine);
+		throw std::runtime_error("cannot start " + command);
+	}
+
+	send("uci");
+	for (auto line = read_line(timeout); line; line = read_line(timeout)) {
+		if (line->starts_with("id name ")) id = line->substr(8);
+		if (*line == "uciok") return;
+	}
+
+	kill(pid, SIGKILL);
+	waitpid(pid, nullptr, 0);
+	close(to_engine);
+	close(from_engine);
+	throw std::runtime_error(command + " did not answer uci");
+}
+
+UciEngine::~UciEngine() {
+	if (!exited) send("quit");
+	close(to_engine);
+	close(from_engine);
+
+	// Give the engine a moment to leave on its own before killing it.
+	for (int i = 0; i < 100; i++) {
+		if (waitpid(pid, nullptr, WNOHANG) == pid) return;
+		usleep(10000);
+	}
+
+	kill(pid, SIGKILL);
+	waitpid(pid, nullptr, 0);
+}
+
+void UciEngine::send(const std::string &line) {
+	std::string data = line + '\n';
+
+	for (size_t done = 0; done < data.size();) {
+		ssize_t n = write(to_engine, data.data() + done, data.size() - done);
+		if (n <= 0) {
+			exited = true;
+			return;
+		}
+		done += static_cast<size_t>(n);
+	}
+}
+
+std::optional<std::string> UciEngine::read_line(Duration timeout) {
+	auto deadline = std::chrono::steady_clock::now() + timeout;
+
+	for (;;) {
+		if (size_t eol = buffer.find('\n'); eol != std::string::npos) {
+			std::string line = buffer.substr(0, eol);
+			buffer.erase(0, eol + 1);
+			if (!line.empty() && line.back() == '\r') line.pop_back();
+			return line;
+		}
+
+		if (exited) return std::nullopt;
+
+		auto left = std::chrono::duration_cast<Duration>(deadline - std::chrono::steady_clock::now());
+		if (left.count() < 0) return std::nullopt;
+
+		pollfd fd{.fd = from_engine, .events = POLLIN, .revents = 0};
+		if (poll(&fd, 1, static_cast<int>(left.count())) <= 0) continue;
+
+		char	chunk[4096];
+		ssize_t n = read(from_engine, chunk, sizeof(chunk));
+		if (n <= 0) {
+			exited = true;
+			continue;
+		}
+
+		buffer.append(chunk, static_cast<size_t>(n));
+	}
+}
+
+std::optional<std::string> UciEngine::wait_for(const std::string &prefix, Duration timeout) {
+	auto deadline = std::chrono::steady_clock::now() + timeout;
+
+	for (;;) {
+		auto left = std::chrono::duration_cast<Duration>(deadline - std::chrono::steady_clock::now());
+		auto line = read_line(std::max(left, Duration(0)));
+
+		if (!line || line->starts_with(prefix)) return line;
+	}
+}
+
+bool UciEngine::configure(const std::vector<std::string> &options, Duration timeout) {
+	for (const auto &option : options) {
+		size_t eq = option.find('=');
+		if (eq == std::string::npos) continue;
+
+		send("setoption name " + option.substr(0, eq) + " value " + option.substr(eq + 1));
+	}
+
+	send("isready");
+	return wait_for("readyok", timeout).has_value();
+}
+
+bool UciEngine::new_game(Duration timeout) {
+	send("ucinewgame");
+	send("isready");
+	return wait_for("readyok", timeout).has_value();
+}
+
+bool UciEngine::alive() const {
+	return !exited;
+}
+
+const std::string &UciEngine::name() const {
+	return id;
+}
+
+}  // namespace tools
@@ -0,0 +1,135 @@
+#include "tools/training_data.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <sstream>
+#include <stdexcept>
+
+namespace tools {
+
+using namespace app::game;
+
+namespace {
+
+constexpr std::string_view PIECE_CHARS = "pnbrqkPNBRQK";
+
+}  // namespace
+
+TrainingEntry pack(const Board &board, int ply, int score, int result) {
+	TrainingEntry entry{};
+
+	entry.occupancy	 = board.pieces();
+	entry.flags		 = static_cast<uint8_t>((board.side_to_move() == WHITE) | board.castling_rights() << 1);
+	entry.ep_square	 = board.en_passant_square();
+	entry.rule50	 = board.halfmove_clock();
+	entry.result	 = static_cast<int8_t>(result);
+	entry.score		 = static_cast<int16_t>(std::clamp(score, -32000, 32000));
+	entry.ply		 = static_cast<uint16_t>(ply);
+
+	bitboard::Bitboard occupied = entry.occupancy;
+	for (size_t i = 0; occupied; i++) {
+		uint8_t piece		   = board.piece_on(bitboard::pop_lsb(occupied));
+		entry.pieces[i / 2]	  |= piece << (4 * (i % 2));
+	}
+
+	return entry;
+}
+
+std::string to_fen(const TrainingEntry &entry) {
+	std::array<char, bitboard::SQUARE_NB> mailbox{};
+
+	bitboard::Bitboard occupied = entry.occupancy;
+	for (size_t i = 0; occupied; i++) {
+		uint8_t piece = (entry.pieces[i / 2] >> (4 * (i % 2))) & 0xF;
+		uint8_t id	  = piece / PIECE_TYPE_NB == WHITE ? 6 + piece % PIECE_TYPE_NB : piece;
+
+		mailbox[bitboard::pop_lsb(occupied)] = PIECE_CHARS[id];
+	}
+
+	std::ostringstream oss;
+	for (uint8_t y = 0; y < 8; y++) {
+		int empty = 0;
+
+		for (uint8_t x = 0; x < 8; x++) {
+			char c = mailbox[bitboard::make_square(x, y)];
+
+			if (!c) {
+				empty++;
+				continue;
+			}
+
+			if (empty) oss << empty;
+			empty = 0;
+			oss << c;
+		}
+
+		if (empty) oss << empty;
+		if (y < 7) oss << '/';
+	}
+
+	uint8_t castling = entry.flags >> 1;
+	oss << (entry.flags & 1 ? " w " : " b ");
+
+	if (!castling) oss << '-';
+	if (castling & WHITE_OO) oss << 'K';
+	if (castling & WHITE_OOO) oss << 'Q';
+	if (castling & BLACK_OO) oss << 'k';
+	if (castling & BLACK_OOO) oss << 'q';
+
+	if (entry.ep_square >= bitboard::NO_SQUARE) {
+		oss << " -";
+	} else {
+		oss << ' ' << static_cast<char>('a' + bitboard::file_of(entry.ep_square))
+			<< static_cast<char>('8' - bitboard::row_of(entry.ep_square));
+	}
+
+	oss << ' ' << static_cast<int>(entry.rule50) << ' ' << 1 + entry.ply / 2;
+	return oss.str();
+}
+
+TrainingWriter::TrainingWriter(const std::filesystem::path &path)
+	: file(path, std::ios::binary | std::ios::trunc),
+	  count(0) {
+	if (!file) throw std::runtime_error("cannot write " + path.string());
+}
+
+void TrainingWriter::write(std::span<const TrainingEntry> entries) {
+	std::scoped_lock guard(lock);
+
+	file.write(reinterpret_cast<const char *>(entries.data()),
+			   static_cast<std::streamsize>(entries.size() * sizeof(TrainingEntry)));
+	count += entries.size();
+}
+
+uint64_t TrainingWriter::written() const {
+	std::scoped_lock guard(lock);
+	return count;
+}
+
+TrainingReader::TrainingReader(const std::filesystem::path &path)
+	: file(path, std::ios::binary),
+	  total(0),
+	  position(0) {
+	if (!file) throw std::runtime_error("cannot open " + path.string());
+	total = std::filesystem::file_size(path) / sizeof(TrainingEntry);
+}
+
+bool TrainingReader::next(TrainingEntry &entry) {
+	if (position == block.size()) {
+		block.resize(BLOCK_SIZE);
+		file.read(reinterpret_cast<char *>(block.data()), BLOCK_SIZE * sizeof(TrainingEntry));
+		block.resize(static_cast<size_t>(file.gcount()) / sizeof(TrainingEntry));
+		position = 0;
+
+		if (block.empty()) return false;
+	}
+
+	entry = block[position++];
+	return true;
+}
+
+size_t TrainingReader::size() const {
+	return total;
+}
+
+}  // namespace tools
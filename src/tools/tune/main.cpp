@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "game/bitbase.hpp"
+#include "game/bitboard.hpp"
+#include "tools/tuner.hpp"
+
+namespace {
+
+void usage(const char *name) {
+	std::cerr << "usage: " << name << " [-o header] [-e epochs] [-t threads] [-r rate] <positions>...\n"
+			  << "  positions: one FEN per line followed by its result (1-0, 0-1, 1/2-1/2, [1.0], [0.5], [0.0]),\n"
+			  << "             or a .bin file written by chess-datagen\n"
+			  << "  header:    where the tuned weights are written, default eval_weights.hpp" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+	std::string				 output	 = "eval_weights.hpp";
+	int						 epochs	 = 1000;
+	size_t					 threads = std::max(1U, std::thread::hardware_concurrency());
+	double					 rate	 = 0.5;
+	std::vector<std::string> inputs;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+
+		if (arg == "-o" && i + 1 < argc) output = argv[++i];
+		else if (arg == "-e" && i + 1 < argc) epochs = std::stoi(argv[++i]);
+		else if (arg == "-t" && i + 1 < argc) threads = std::stoul(argv[++i]);
+		else if (arg == "-r" && i + 1 < argc) rate = std::stod(argv[++i]);
+		else if (arg.starts_with('-')) return usage(argv[0]), EXIT_FAILURE;
+		else inputs.push_back(arg);
+	}
+
+	if (inputs.empty()) return usage(argv[0]), EXIT_FAILURE;
+
+	app::game::bitboard::init();
+	app::game::bitbase::init();
+
+	tools::Tuner tuner(threads);
+	auto		 start = std::chrono::steady_clock::now();
+
+	try {
+		for (const auto &input : inputs) std::cout << input << ": " << tuner.load(input) << " positions" << std::endl;
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	auto seconds = [&start] {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	};
+
+	std::cout << "loaded " << tuner.size() << " positions in " << seconds() << " s" << std::endl;
+	std::cout << "K = " << tuner.fit_scaling() << ", error " << tuner.error() << std::endl;
+
+	start = std::chrono::steady_clock::now();
+	for (int e = 1; e <= epochs; e++) {
+		double error = tuner.epoch(rate);
+
+		if (e % 50 == 0 || e == epochs) {
+			double elapsed = seconds();
+			std::cout << "epoch " << e << "  error " << error << "  "
+					  << static_cast<uint64_t>(static_cast<double>(tuner.size()) * e / elapsed) << " positions/s"
+					  << std::endl;
+		}
+	}
+
+	tuner.write_header(output);
+	std::cout << "weights written to " << output << std::endl;
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,319 @@
+#include "tools/tuner.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "game/eval_weights.hpp"
+#include "tools/training_data.hpp"
+
+namespace tools {
+
+using namespace app::game;
+
+namespace {
+
+constexpr size_t LOAD_BATCH		= 1 << 18;
+constexpr double LOG10_OVER_400 = 2.302585092994046 / 400;
+
+// Written next to each row of the generated header, in the order of eval::Term.
+constexpr std::array<std::string_view, eval::TERM_NB> TERM_NAMES{
+	"PAWN_VALUE",
+	"KNIGHT_VALUE",
+	"BISHOP_VALUE",
+	"ROOK_VALUE",
+	"QUEEN_VALUE",
+	"BISHOP_PAIR",
+	"KNIGHT_MOBILITY",
+	"BISHOP_MOBILITY",
+	"ROOK_MOBILITY",
+	"QUEEN_MOBILITY",
+	"SPACE",
+	"KING_ZONE_ATTACKS",
+	"PAWN_SHIELD",
+	"PASSED_PAWN",
+	"DOUBLED_PAWN",
+	"ISOLATED_PAWN",
+};
+
+// Result in half points for white, from the last marker found on the line.
+std::optional<uint8_t> parse_result(std::string_view line) {
+	constexpr std::array<std::pair<std::string_view, uint8_t>, 6> MARKERS{{
+		{"1/2-1/2", 1},
+		{"1-0", 2},
+		{"0-1", 0},
+		{"[0.5]", 1},
+		{"[1.0]", 2},
+		{"[0.0]", 0},
+	}};
+
+	size_t				   best_pos = 0;
+	std::optional<uint8_t> result;
+
+	for (const auto &[marker, value] : MARKERS) {
+		size_t pos = line.rfind(marker);
+		if (pos != std::string_view::npos && (!result || pos > best_pos)) {
+			best_pos = pos;
+			result	 = value;
+		}
+	}
+
+	return result;
+}
+
+std::optional<PackedPosition> pack(Board &board, const std::string &line) {
+	auto result = parse_result(line);
+	if (!result) return std::nullopt;
+
+	try {
+		board.set_fen(line);
+	} catch (const InvalidFenException &) {
+		return std::nullopt;
+	}
+
+	if (board.in_check(board.side_to_move())) return std::nullopt;
+	if (std::popcount(board.pieces()) == 3 && board.pieces(PAWN)) return std::nullopt;
+
+	eval::Trace	   trace = eval::trace(board);
+	PackedPosition p{};
+
+	for (size_t t = 0; t < eval::TERM_NB; t++)
+		p.features[t] = static_cast<int8_t>(std::clamp(trace.features[t], -127, 127));
+	p.phase	 = static_cast<uint8_t>(trace.phase);
+	p.result = *result;
+
+	return p;
+}
+
+double sigmoid(double k, double eval) {
+	return 1.0 / (1.0 + std::exp(-k * eval * LOG10_OVER_400));
+}
+
+double evaluate(const Tuner::Weights &w, const PackedPosition &p) {
+	double mg = 0, eg = 0;
+
+	for (size_t t = 0; t < eval::TERM_NB; t++) {
+		mg += w[t][0] * p.features[t];
+		eg += w[t][1] * p.features[t];
+	}
+
+	return (mg * p.phase + eg * (eval::PHASE_MAX - p.phase)) / eval::PHASE_MAX;
+}
+
+}  // namespace
+
+Tuner::Tuner(size_t thread_count)
+	: threads(std::max<size_t>(thread_count, 1)),
+	  scaling(1.0),
+	  moment1{},
+	  moment2{},
+	  steps(0) {
+	for (size_t t = 0; t < eval::TERM_NB; t++) {
+		for (size_t phase = 0; phase < 2; phase++) params[t][phase] = eval::WEIGHTS[t][phase];
+	}
+}
+
+template <typename Job>
+void Tuner::parallel(size_t count, Job job) const {
+	std::vector<std::thread> workers;
+	size_t					 chunk = (count + threads - 1) / threads;
+
+	for (size_t i = 0; i < threads; i++) {
+		size_t begin = std::min(count, i * chunk);
+		size_t end	 = std::min(count, begin + chunk);
+		workers.emplace_back([&job, begin, end, i] { job(begin, end, i); });
+	}
+
+	for (auto &worker : workers) worker.join();
+}
+
+// Lines are read in batches and packed in parallel, so parsing keeps up with the disk on large sets. Self-play
+// files (.bin) are turned into the same lines first.
+size_t Tuner::load(const std::filesystem::path &path) {
+	constexpr std::array<std::string_view, 3> RESULTS = {" 0-1", " 1/2-1/2", " 1-0"};
+
+	const bool					  binary = path.extension() == ".bin";
+	std::ifstream				  text;
+	std::optional<TrainingReader> reader;
+
+	if (binary) {
+		reader.emplace(path);
+	} else {
+		text.open(path);
+		if (!text) throw std::runtime_error("cannot open " + path.string());
+	}
+
+	auto read_line = [&](std::string &line) -> bool {
+		if (!binary) return static_cast<bool>(std::getline(text, line));
+
+		TrainingEntry entry;
+		if (!reader->next(entry)) return false;
+
+		line = to_fen(entry);
+		line += RESULTS[std::clamp(entry.result + 1, 0, 2)];
+		return true;
+	};
+
+	size_t										before = positions.size();
+	std::vector<std::string>					lines(LOAD_BATCH);
+	std::vector<std::optional<PackedPosition> > packed(LOAD_BATCH);
+	std::vector<std::unique_ptr<Board> >		boards;
+
+	for (size_t i = 0; i < threads; i++) boards.push_back(std::make_unique<Board>(false));
+
+	for (size_t count = LOAD_BATCH; count == LOAD_BATCH;) {
+		count = 0;
+		while (count < LOAD_BATCH && read_line(lines[count])) count++;
+
+		parallel(count, [&](size_t begin, size_t end, size_t thread) {
+			for (size_t i = begin; i < end; i++) packed[i] = pack(*boards[thread], lines[i]);
+		});
+
+		for (size_t i = 0; i < count; i++) {
+			if (packed[i]) positions.push_back(*packed[i]);
+		}
+	}
+
+	return positions.size() - before;
+}
+
+double Tuner::error(double k) const {
+	std::vector<double> sums(threads);
+
+	parallel(positions.size(), [&](size_t begin, size_t end, size_t thread) {
+		double sum = 0;
+		for (size_t i = begin; i < end; i++) {
+			double diff	 = positions[i].result / 2.0 - sigmoid(k, evaluate(params, positions[i]));
+			sum			+= diff * diff;
+		}
+		sums[thread] = sum;
+	});
+
+	double total = 0;
+	for (double s : sums) total += s;
+	return positions.empty() ? 0 : total / static_cast<double>(positions.size());
+}
+
+double Tuner::error() const {
+	return error(scaling);
+}
+
+double Tuner::fit_scaling() {
+	double lo = 0.1, hi = 3.0;
+
+	for (int i = 0; i < 40; i++) {
+		double a = lo + (hi - lo) / 3;
+		double b = hi - (hi - lo) / 3;
+
+		if (error(a) < error(b)) {
+			hi = b;
+		} else {
+			lo = a;
+		}
+	}
+
+	scaling = (lo + hi) / 2;
+	return scaling;
+}
+
+// The derivative of (r - s)^2 with respect to a middlegame weight is -2 (r - s) s (1 - s) K' f phase / 24,
+// and symmetrically for endgame weights with 24 - phase.
+double Tuner::epoch(double learning_rate) {
+	constexpr double BETA1 = 0.9, BETA2 = 0.999, EPSILON = 1e-8;
+
+	std::vector<Gradient> gradients(threads, Gradient{});
+	std::vector<double>	  errors(threads);
+
+	parallel(positions.size(), [&](size_t begin, size_t end, size_t thread) {
+		Gradient &g	  = gradients[thread];
+		double	  err = 0;
+
+		for (size_t i = begin; i < end; i++) {
+			const PackedPosition &p	   = positions[i];
+			double				  s	   = sigmoid(scaling, evaluate(params, p));
+			double				  diff = p.result / 2.0 - s;
+			double				  base = -2 * diff * s * (1 - s) * scaling * LOG10_OVER_400 / eval::PHASE_MAX;
+			double				  mg   = base * p.phase;
+			double				  eg   = base * (eval::PHASE_MAX - p.phase);
+
+			err += diff * diff;
+			for (size_t t = 0; t < eval::TERM_NB; t++) {
+				if (!p.features[t]) continue;
+				g[t][0] += mg * p.features[t];
+				g[t][1] += eg * p.features[t];
+			}
+		}
+
+		errors[thread] = err;
+	});
+
+	Gradient total{};
+	double	 err = 0;
+	for (size_t i = 0; i < threads; i++) {
+		err += errors[i];
+		for (size_t t = 0; t < eval::TERM_NB; t++) {
+			total[t][0] += gradients[i][t][0];
+			total[t][1] += gradients[i][t][1];
+		}
+	}
+
+	auto n = static_cast<double>(std::max<size_t>(positions.size(), 1));
+	steps++;
+
+	for (size_t t = 0; t < eval::TERM_NB; t++) {
+		for (size_t phase = 0; phase < 2; phase++) {
+			double g			= total[t][phase] / n;
+			moment1[t][phase]	= BETA1 * moment1[t][phase] + (1 - BETA1) * g;
+			moment2[t][phase]	= BETA2 * moment2[t][phase] + (1 - BETA2) * g * g;
+
+			double m			= moment1[t][phase] / (1 - std::pow(BETA1, steps));
+			double v			= moment2[t][phase] / (1 - std::pow(BETA2, steps));
+			params[t][phase]   -= learning_rate * m / (std::sqrt(v) + EPSILON);
+		}
+	}
+
+	return err / n;
+}
+
+// Same layout as the hand-written file, so that tuned weights replace it without any other change.
+void Tuner::write_header(const std::filesystem::path &path) const {
+	std::ofstream out(path);
+	if (!out) throw std::runtime_error("cannot write " + path.string());
+
+	out << "#ifndef CHESS_INCLUDE_GAME_EVAL_WEIGHTS_HPP\n#define CHESS_INCLUDE_GAME_EVAL_WEIGHTS_HPP\n\n";
+	out << "#include <array>\n#include <cstdint>\n\n#include \"game/evaluate.hpp\"\n\n";
+	out << "namespace app::game::eval {\n\n";
+	out << "// Middlegame and endgame weight of each term, in centipawns.\n";
+	out << "// Generated by chess-tune from " << positions.size() << " positions.\n";
+	out << "constexpr std::array<std::array<int16_t, 2>, TERM_NB> WEIGHTS{{\n";
+
+	for (size_t t = 0; t < eval::TERM_NB; t++) {
+		std::string row = "{" + std::to_string(std::lround(params[t][0])) + ", " +
+						  std::to_string(std::lround(params[t][1])) + "},";
+
+		// Comments line up on column 20 with four-column tabs, the row itself starting on column 4.
+		size_t column = 4 + row.size();
+		out << '\t' << row << '\t';
+		for (column = (column / 4 + 1) * 4; column < 20; column += 4) out << '\t';
+		out << "// " << TERM_NAMES[t] << '\n';
+	}
+
+	out << "}};\n\n}  // namespace app::game::eval\n\n#endif\t// CHESS_INCLUDE_GAME_EVAL_WEIGHTS_HPP\n";
+}
+
+size_t Tuner::size() const {
+	return positions.size();
+}
+
+const Tuner::Weights &Tuner::weights() const {
+	return params;
+}
+
+}  // namespace tools
@@ -0,0 +1,82 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "game/bitboard.hpp"
+#include "game/game.hpp"
+#include "game/movegen.hpp"
+
+namespace {
+
+struct PerftCase {
+	const char *fen;
+	int			depth;
+	uint64_t	nodes;
+};
+
+// Rights and en passant squares that cannot be used are dropped when reading a FEN.
+struct FenCase {
+	const char *fen;
+	const char *normalized;
+};
+
+constexpr PerftCase PERFT_CASES[] = {
+	{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 4, 197281},
+	{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3, 97862},
+	{"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4, 43238},
+	{"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 3, 9467},
+	{"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3, 62379},
+	{"4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", 1, 7},
+};
+
+constexpr FenCase FEN_CASES[] = {
+	// Castling rights without the rook, or without the king, on its home square.
+	{"4k3/8/8/8/8/8/8/4K3 w K - 0 1", "4k3/8/8/8/8/8/8/4K3 w - - 0 1"},
+	{"r3k3/8/8/8/8/8/8/3K3R b KQkq - 0 1", "r3k3/8/8/8/8/8/8/3K3R b q - 0 1"},
+
+	// En passant squares without a pawn that could just have been pushed through them.
+	{"4k3/8/8/4P3/8/8/8/4K3 w - d6 0 1", "4k3/8/8/4P3/8/8/8/4K3 w - - 0 1"},
+	{"4k3/8/8/8/3pP3/8/8/4K3 w - e3 0 1", "4k3/8/8/8/3pP3/8/8/4K3 w - - 0 1"},
+	{"4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", "4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1"},
+};
+
+constexpr int FEN_PERFT_DEPTH = 3;
+
+}  // namespace
+
+int main() {
+	app::game::bitboard::init();
+
+	app::game::Board board(true);
+	int				 failures = 0;
+
+	for (const auto &c : PERFT_CASES) {
+		board.set_fen(c.fen);
+
+		if (uint64_t nodes = app::game::perft(board, c.depth); nodes != c.nodes) {
+			std::cerr << c.fen << ": perft " << c.depth << " gave " << nodes << ", expected " << c.nodes << '\n';
+			failures++;
+		}
+	}
+
+	for (const auto &c : FEN_CASES) {
+		board.set_fen(c.normalized);
+		uint64_t expected = app::game::perft(board, FEN_PERFT_DEPTH);
+
+		board.set_fen(c.fen);
+		uint64_t nodes = app::game::perft(board, FEN_PERFT_DEPTH);
+
+		if (board.fen() != c.normalized) {
+			std::cerr << c.fen << ": read back as \"" << board.fen() << "\", expected \"" << c.normalized << "\"\n";
+			failures++;
+		}
+		if (nodes != expected) {
+			std::cerr << c.fen << ": perft " << FEN_PERFT_DEPTH << " gave " << nodes << ", expected " << expected
+					  << '\n';
+			failures++;
+		}
+	}
+
+	if (failures) std::cerr << failures << " failures" << std::endl;
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}